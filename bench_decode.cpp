@@ -0,0 +1,164 @@
+//------------------------------------------------------------------------------
+/// @brief benchmark of the batch address decoding kernels
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+#include "decode.h"
+#include "hdd.h"
+#include "workload.h"
+using namespace std;
+
+/// number of addresses decoded per run
+#define BENCH_ADDRESSES 1000000
+
+/// addresses decoded with the original track-by-track walk
+#define BENCH_LINEAR    10000
+
+/// HDD with access to the scalar decoder
+class BenchHDD : public HDD {
+  public:
+    BenchHDD(void) : HDD(8, 25000, 4000, 14000, 5400, 512, 0.008, 0.00005) {}
+
+    bool decode(uint64 address, HDD_Position *pos)
+    {
+      return HDD::decode(address, pos);
+    }
+
+    /// the original decoder: walk through the tracks
+    bool decode_linear(uint64 address, HDD_Position *pos)
+    {
+      address /= _sector_size;
+      for (uint32 track=0; track<tracks_per_sf; track++) {
+        uint64 n = num_of_sector(track);
+        if (address < n * _surfaces) {
+          pos->surface = address / n;
+          pos->track = track;
+          pos->sector = address % n;
+          pos->max_access = (n - pos->sector) +
+                            (_surfaces - pos->surface - 1) * n;
+          return true;
+        }
+        address -= n * _surfaces;
+      }
+      return false;
+    }
+};
+
+static double now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static bool same(const HDD_Position &a, const HDD_Position &b)
+{
+  return (a.surface == b.surface) && (a.track == b.track) &&
+         (a.sector == b.sector) && (a.max_access == b.max_access);
+}
+
+static void result(const char *name, double t, size_t n, double base)
+{
+  double ns = t / n * 1e9;
+  cout << "  " << left << setw(18) << name << right << fixed
+       << setprecision(2) << setw(10) << ns << " ns/address"
+       << setw(10) << (base > 0.0 ? base / ns : 1.0) << "x" << endl;
+}
+
+int main(int argc, char *argv[])
+{
+  BenchHDD hdd;
+  Random rng(argc > 1 ? strtoull(argv[1], NULL, 10) : 1);
+
+  // random addresses across the capacity; every 1000th is beyond the end
+  vector<uint64> address(BENCH_ADDRESSES);
+  for (size_t i=0; i<address.size(); i++) {
+    address[i] = i % 1000 == 999 ? hdd.capacity() + rng.next() % 4096
+                                 : rng.next() % hdd.capacity();
+  }
+
+  cout << "decoding " << address.size() << " random addresses on "
+       << hdd.capacity() / 1000000000 << " GB" << endl;
+
+  // reference: one decode() call per address
+  vector<HDD_Position> ref(address.size());
+  double t = now();
+  size_t valid = 0;
+  for (size_t i=0; i<address.size(); i++) {
+    if (hdd.decode(address[i], &ref[i])) valid++;
+    else memset(&ref[i], 0, sizeof(ref[i]));
+  }
+  double base = (now() - t) / address.size() * 1e9;
+
+  HDD_Position lin;
+  bool ok = true;
+  t = now();
+  for (size_t i=0; i<BENCH_LINEAR; i++) {
+    if (hdd.decode_linear(address[i], &lin)) ok &= same(lin, ref[i]);
+  }
+  result("linear walk", now() - t, BENCH_LINEAR, base);
+  result("decode()", base * address.size() * 1e-9, address.size(), base);
+  if (!ok) cout << "  linear walk: MISMATCH" << endl;
+
+  // batch kernels
+  DecodeIsa isa[] = { DECODE_SCALAR, DECODE_AVX2, DECODE_AVX512 };
+  vector<HDD_Position> pos(address.size());
+  for (size_t k=0; k<sizeof(isa)/sizeof(isa[0]); k++) {
+    string name = string("batch ") + decode_name(isa[k]);
+    if (!decode_supported(isa[k])) {
+      cout << "  " << left << setw(18) << name << right
+           << "  not supported by this CPU" << endl;
+      continue;
+    }
+
+    hdd.set_decode(isa[k]);
+    double best = 0.0;
+    for (int run=0; run<5; run++) {
+      t = now();
+      size_t v = hdd.decode_batch(&address[0], address.size(), &pos[0]);
+      t = now() - t;
+      if ((run == 0) || (t < best)) best = t;
+      ok &= v == valid;
+    }
+    for (size_t i=0; i<address.size(); i++) ok &= same(pos[i], ref[i]);
+    result(name.c_str(), best, address.size(), base);
+  }
+
+  cout << (ok ? "all kernels agree with decode()" : "MISMATCH") << endl;
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,254 @@
+//------------------------------------------------------------------------------
+/// @brief block layer: request merging and splitting
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <cstdio>
+#include <cstring>
+
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+
+#include "blocklayer.h"
+#include "options.h"
+#include "tracing.h"
+using namespace std;
+
+//------------------------------------------------------------------------------
+// BlockConfig
+//
+void block_defaults(BlockConfig *cfg)
+{
+  cfg->plug         = 0.002;
+  cfg->max_transfer = 512 * 1024;
+  cfg->merge        = true;
+}
+
+static bool parse_option(const char *key, const char *val, void *ctx)
+{
+  BlockConfig *cfg = (BlockConfig*)ctx;
+  char c;
+
+  if (strcmp(key, "plug") == 0) {
+    return (sscanf(val, "%lf%c", &cfg->plug, &c) == 1) && (cfg->plug >= 0.0);
+  } else if (strcmp(key, "max") == 0) {
+    return parse_size(val, &cfg->max_transfer) && (cfg->max_transfer > 0);
+  } else if (strcmp(key, "merge") == 0) {
+    cfg->merge = strcmp(val, "1") == 0;
+    return cfg->merge || (strcmp(val, "0") == 0);
+  }
+
+  return false;
+}
+
+bool block_parse(const char *spec, BlockConfig *cfg)
+{
+  return parse_options(spec, parse_option, cfg, "block layer");
+}
+
+
+//------------------------------------------------------------------------------
+// BlockLayer
+//
+BlockLayer::BlockLayer(Disk *disk, const BlockConfig &cfg)
+  : _cfg(cfg), _disk(disk), _plug(sim_time(cfg.plug)), _first(0), _last(0),
+    _requests(0), _merged(0), _dispatched(0), _split(0), _commands(0),
+    _bytes(0), _disk_bytes(0), _trace_device(TRACE_DEVICE())
+{
+}
+
+void BlockLayer::run(Workload *wl, vector<SimTime> *done)
+{
+  // the queue in order of arrival, and for each direction the queued
+  // requests in order of their start address
+  map<uint64, Pending> queue;
+  multimap<uint64, uint64> sorted[2];
+  vector<uint64> taken;
+  Pending next;
+  bool   more = wl->next(&next.req);
+  uint64 index = 0;
+  SimTime busy = _last;
+
+  while (more || !queue.empty()) {
+    // the disk is idle and nothing is queued: wait for the next request
+    if (queue.empty()) {
+      next.index = index++;
+      enqueue(next, &queue, sorted);
+      more = wl->next(&next.req);
+    }
+
+    // dispatch when the disk becomes idle; a request that found the disk
+    // idle keeps the queue plugged for a while
+    Request oldest = queue.begin()->second.req;
+    SimTime ts = oldest.ts >= busy ? oldest.ts + _plug : busy;
+
+    // queue the requests arriving until then
+    while (more && (next.req.ts <= ts)) {
+      next.index = index++;
+      enqueue(next, &queue, sorted);
+      more = wl->next(&next.req);
+    }
+
+    // grow the command by its neighbours in address order until nothing
+    // changes: the requests starting in [lo, hi], and the nearest one
+    // starting below lo if it reaches lo
+    char   rw = oldest.rw;
+    uint64 lo = oldest.address, hi = oldest.address + oldest.size;
+    multimap<uint64, uint64> &by_address = sorted[rw == 'w'];
+    taken.assign(1, queue.begin()->first);
+    remove(queue.begin()->second, &by_address);
+    bool grown = _cfg.merge;
+    while (grown) {
+      grown = false;
+
+      multimap<uint64, uint64>::iterator it = by_address.lower_bound(lo);
+      while ((it != by_address.end()) && (it->first <= hi)) {
+        const Request &r = queue[it->second].req;
+        uint64 h = r.address + r.size > hi ? r.address + r.size : hi;
+        if (h - lo > _cfg.max_transfer) {
+          ++it;
+          continue;
+        }
+        hi = h;
+        taken.push_back(it->second);
+        by_address.erase(it++);
+        grown = true;
+        _merged++;
+      }
+
+      it = by_address.lower_bound(lo);
+      if (it != by_address.begin()) {
+        --it;
+        const Request &r = queue[it->second].req;
+        uint64 end = r.address + r.size;
+        uint64 h = end > hi ? end : hi;
+        if ((end >= lo) && (h - r.address <= _cfg.max_transfer)) {
+          lo = r.address;
+          hi = h;
+          taken.push_back(it->second);
+          by_address.erase(it);
+          grown = true;
+          _merged++;
+        }
+      }
+    }
+
+    SimTime end = dispatch(ts, rw, lo, hi);
+
+    // the requests of the command complete with it
+    sort(taken.begin(), taken.end());
+    for (size_t i=0; i<taken.size(); i++) {
+      const Pending &p = queue[taken[i]];
+      if (_requests == 0) _first = p.req.ts;
+      _requests++;
+      _bytes += p.req.size;
+      _response.add(sim_seconds(end - p.req.ts));
+      if (done) {
+        if (done->size() <= p.index) done->resize(p.index + 1);
+        (*done)[p.index] = end;
+      }
+      queue.erase(taken[i]);
+    }
+
+    busy = end;
+  }
+}
+
+void BlockLayer::enqueue(const Pending &p, map<uint64, Pending> *queue,
+                         multimap<uint64, uint64> *sorted)
+{
+  (*queue)[p.index] = p;
+  sorted[p.req.rw == 'w'].insert(make_pair(p.req.address, p.index));
+}
+
+void BlockLayer::remove(const Pending &p, multimap<uint64, uint64> *by_address)
+{
+  multimap<uint64, uint64>::iterator it;
+  it = by_address->lower_bound(p.req.address);
+  while (it->second != p.index) ++it;
+  by_address->erase(it);
+}
+
+SimTime BlockLayer::dispatch(SimTime ts, char rw, uint64 lo, uint64 hi)
+{
+  _dispatched++;
+  if (hi - lo > _cfg.max_transfer) _split++;
+
+  // parts of a split command are served back to back
+  uint64 address = lo;
+  do {
+    uint64 size = hi - address < _cfg.max_transfer ? hi - address
+                                                    : _cfg.max_transfer;
+    TRACE_BEGIN(_trace_device, _commands);
+    SimTime end = rw == 'w' ? _disk->write(ts, address, size)
+                            : _disk->read(ts, address, size);
+    TRACE_REQUEST(rw, ts, ts, end, address, size);
+    _service.add(sim_seconds(end - ts));
+    _commands++;
+    _disk_bytes += size;
+
+    ts = end;
+    address += size;
+  } while (address < hi);
+
+  if (ts > _last) _last = ts;
+  return ts;
+}
+
+double BlockLayer::merge_ratio(void) const
+{
+  return _dispatched > 0 ? (double)_requests / _dispatched : 0.0;
+}
+
+void BlockLayer::report(ostream &os) const
+{
+  os.precision(6);
+  os << "block layer (plug " << dec << fixed << _cfg.plug << " s, max "
+     << _cfg.max_transfer << " bytes, merging "
+     << (_cfg.merge ? "on" : "off") << "):" << endl
+     << "  requests:    " << _requests << endl
+     << "  commands:    " << _commands << " (" << _merged
+     << " requests merged, " << _split << " commands split)" << endl
+     << "  merge ratio: " << setprecision(3) << merge_ratio() << endl
+     << "  bytes:       " << _bytes << " requested, " << _disk_bytes
+     << " transferred" << endl
+     << setprecision(6)
+     << "  elapsed:     " << elapsed() << endl
+     << "  iops:        " << (elapsed() > 0.0 ? _requests / elapsed() : 0.0)
+     << endl
+     << "  MB/s:        " << (elapsed() > 0.0 ? _bytes / elapsed() / 1e6 : 0.0)
+     << endl
+     << "  utilization: "
+     << (elapsed() > 0.0 ? _service.sum() / elapsed() : 0.0) << endl;
+  _service.print(os, "service");
+  _response.print(os, "response");
+  os << endl;
+}
@@ -0,0 +1,173 @@
+//------------------------------------------------------------------------------
+/// @brief block layer: request merging and splitting
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_BLOCKLAYER_H__
+#define __CA_BLOCKLAYER_H__
+
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include "disk.h"
+#include "stats.h"
+#include "workload.h"
+using namespace std;
+
+//------------------------------------------------------------------------------
+/// @brief configuration of the block layer
+///
+/// A configuration is parsed from a comma-separated list of key=value pairs
+/// (sizes accept K, M, G suffixes):
+///
+/// - plug=<seconds>                 time a request arriving at an idle disk
+///                                  is held back to collect mergeable requests
+/// - max=<bytes>                    largest command sent to the disk; merges
+///                                  stop at this size, larger requests are
+///                                  split
+/// - merge=0|1                      merge contiguous and overlapping requests
+///
+typedef struct _block_config {
+  double plug;                      ///< plug window in seconds
+  uint64 max_transfer;              ///< largest command in bytes
+  bool   merge;                     ///< merge adjacent requests
+} BlockConfig;
+
+/// @brief initialize @a cfg with default values
+void block_defaults(BlockConfig *cfg);
+
+/// @brief parse @a spec into @a cfg (on top of the values already in @a cfg)
+/// @retval true if @a spec was parsed successfully, false otherwise
+bool block_parse(const char *spec, BlockConfig *cfg);
+
+
+//------------------------------------------------------------------------------
+/// @brief block layer between the request stream and a disk
+///
+/// BlockLayer replays a request stream (open loop) like Replay, but requests
+/// pass through a queue in which they are merged and split before they reach
+/// the disk, as in the block layer of an operating system:
+///
+/// - a request arriving at an idle disk with an empty queue plugs the queue
+///   for BlockConfig::plug seconds,
+/// - when the disk is idle and the queue unplugged, the oldest request is
+///   dispatched. Queued requests of the same direction that start within
+///   the command, or the nearest one that starts before it if it reaches
+///   the command, are merged into it as long as the command does not exceed
+///   BlockConfig::max_transfer,
+/// - a command larger than BlockConfig::max_transfer (a single large request)
+///   is split and its parts are served one after the other.
+///
+/// Every original request completes when the command holding it completes,
+/// so response times are those seen by the issuer of the request. The queue
+/// is kept in order of arrival and, for each direction, in order of the
+/// start address, so a merge only looks at the neighbours of the command.
+///
+class BlockLayer {
+  public:
+    /// @name constructor/destructor
+    /// @{
+
+    /// @brief constructor
+    /// @param disk disk to serve the commands
+    /// @param cfg block layer configuration
+    BlockLayer(Disk *disk, const BlockConfig &cfg);
+
+    /// @}
+
+
+    /// @name replay
+    /// @{
+
+    /// @brief open-loop replay of @a wl. With @a done, the completion time of
+    ///        each request is appended in the order of the stream.
+    void   run(Workload *wl, vector<SimTime> *done=NULL);
+
+    /// @}
+
+
+    /// @name results
+    /// @{
+
+    /// @brief print a summary of the replay to @a os
+    void   report(ostream &os) const;
+
+    uint64 requests(void) const { return _requests; } ///< # original requests
+    uint64 commands(void) const { return _commands; } ///< # disk commands
+    uint64 bytes(void) const { return _bytes; }       ///< # bytes requested
+    double elapsed(void) const { return sim_seconds(_last - _first); } ///< s
+
+    /// @brief original requests per command before splitting
+    double merge_ratio(void) const;
+
+    const LatencyStats &service(void) const { return _service; }   ///< service
+    const LatencyStats &response(void) const { return _response; } ///< response
+
+    /// @}
+
+
+  protected:
+    /// @brief a queued request
+    typedef struct _pending {
+      Request req;                  ///< the request
+      uint64  index;                ///< position in the stream
+    } Pending;
+
+    BlockConfig _cfg;               ///< configuration
+    Disk  *_disk;                   ///< disk serving the commands
+    SimTime _plug;                  ///< plug window
+    SimTime _first;                 ///< arrival time of the first request
+    SimTime _last;                  ///< completion time of the last command
+    uint64 _requests;               ///< number of original requests
+    uint64 _merged;                 ///< requests merged into another command
+    uint64 _dispatched;             ///< commands before splitting
+    uint64 _split;                  ///< commands that were split
+    uint64 _commands;               ///< commands sent to the disk
+    uint64 _bytes;                  ///< bytes requested
+    uint64 _disk_bytes;             ///< bytes transferred by the disk
+    LatencyStats _service;          ///< service times of the commands
+    LatencyStats _response;         ///< response times of the requests
+    uint32 _trace_device;           ///< device in the trace (see tracing.h)
+
+    /// @brief add @a p to the @a queue and to @a sorted[0] (reads) or
+    ///        @a sorted[1] (writes)
+    void   enqueue(const Pending &p, map<uint64, Pending> *queue,
+                   multimap<uint64, uint64> *sorted);
+
+    /// @brief remove @a p from @a by_address
+    void   remove(const Pending &p, multimap<uint64, uint64> *by_address);
+
+    /// @brief serve the command [@a lo, @a hi) starting at @a ts
+    /// @retval completion time
+    SimTime dispatch(SimTime ts, char rw, uint64 lo, uint64 hi);
+};
+
+#endif // __CA_BLOCKLAYER_H__
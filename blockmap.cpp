@@ -0,0 +1,94 @@
+//------------------------------------------------------------------------------
+/// @brief hash index from block numbers to slots
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include "blockmap.h"
+using namespace std;
+
+#define BM_EMPTY ((uint64)-1)       ///< marker of unused entries
+
+//------------------------------------------------------------------------------
+// BlockMap
+//
+BlockMap::BlockMap(uint64 max_entries)
+  : _size(0)
+{
+  uint64 n = 16;
+  while (n < 2 * max_entries) n <<= 1;
+
+  _key.assign(n, BM_EMPTY);
+  _val.assign(n, 0);
+  _mask = n - 1;
+}
+
+bool BlockMap::find(uint64 key, uint32 *val) const
+{
+  for (uint64 i = home(key); _key[i] != BM_EMPTY; i = (i + 1) & _mask) {
+    if (_key[i] == key) {
+      *val = _val[i];
+      return true;
+    }
+  }
+  return false;
+}
+
+void BlockMap::insert(uint64 key, uint32 val)
+{
+  uint64 i = home(key);
+  while ((_key[i] != BM_EMPTY) && (_key[i] != key)) i = (i + 1) & _mask;
+
+  if (_key[i] == BM_EMPTY) _size++;
+  _key[i] = key;
+  _val[i] = val;
+}
+
+void BlockMap::remove(uint64 key)
+{
+  uint64 i = home(key);
+  while (_key[i] != key) {
+    if (_key[i] == BM_EMPTY) return;
+    i = (i + 1) & _mask;
+  }
+
+  // backward-shift the following entries of the cluster into the hole
+  uint64 hole = i;
+  for (i = (i + 1) & _mask; _key[i] != BM_EMPTY; i = (i + 1) & _mask) {
+    uint64 h = home(_key[i]);
+    // move entry i if its home position is not in (hole, i]
+    if (((i - h) & _mask) >= ((i - hole) & _mask)) {
+      _key[hole] = _key[i];
+      _val[hole] = _val[i];
+      hole = i;
+    }
+  }
+  _key[hole] = BM_EMPTY;
+  _size--;
+}
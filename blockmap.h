@@ -0,0 +1,99 @@
+//------------------------------------------------------------------------------
+/// @brief hash index from block numbers to slots
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_BLOCKMAP_H__
+#define __CA_BLOCKMAP_H__
+
+#include <vector>
+
+#include "disk.h"
+using namespace std;
+
+//------------------------------------------------------------------------------
+/// @brief hash index from block numbers to slots
+///
+/// BlockMap is an open-addressing hash table (linear probing, backward-shift
+/// deletion) mapping 64-bit block numbers to 32-bit slot numbers. Keys and
+/// values are kept in separate arrays (12 bytes per entry); the table holds at
+/// most @a max_entries entries at a load factor below 0.5, so lookups, inserts
+/// and removals take O(1) time and the memory use is fixed at construction.
+///
+class BlockMap {
+  public:
+    /// @name constructor/destructor
+    /// @{
+
+    /// @brief constructor
+    /// @param max_entries maximal number of entries
+    BlockMap(uint64 max_entries);
+
+    /// @}
+
+
+    /// @name access methods
+    /// @{
+
+    /// @brief look up @a key
+    /// @param key block number
+    /// @param val (output) slot of @a key
+    /// @retval true if @a key is in the index, false otherwise
+    bool   find(uint64 key, uint32 *val) const;
+
+    /// @brief insert or update @a key
+    void   insert(uint64 key, uint32 val);
+
+    /// @brief remove @a key (if present)
+    void   remove(uint64 key);
+
+    /// @brief number of entries
+    uint64 size(void) const { return _size; }
+
+    /// @}
+
+
+  protected:
+    vector<uint64> _key;            ///< keys (BM_EMPTY: unused)
+    vector<uint32> _val;            ///< values
+    uint64 _mask;                   ///< table size - 1
+    uint64 _size;                   ///< number of entries
+
+    /// @brief home position of @a key
+    inline uint64 home(uint64 key) const
+    {
+      key ^= key >> 33;
+      key *= 0xff51afd7ed558ccdULL;
+      key ^= key >> 33;
+      return key & _mask;
+    }
+};
+
+#endif // __CA_BLOCKMAP_H__
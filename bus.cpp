@@ -0,0 +1,324 @@
+//------------------------------------------------------------------------------
+/// @brief host interface and drive buffer of an HDD
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+
+#include "bus.h"
+#include "options.h"
+#include "snapshot.h"
+using namespace std;
+
+/// @brief named links and their payload bandwidth in MB/s
+static const struct { const char *name; double mbs; } links[] = {
+  { "sata1", 150.0 }, { "sata2", 300.0 }, { "sata3", 600.0 },
+  { "sas3", 300.0 },  { "sas6", 600.0 },  { "sas12", 1200.0 },
+};
+
+//------------------------------------------------------------------------------
+// BusConfig
+//
+void bus_defaults(BusConfig *cfg)
+{
+  cfg->rate       = 600e6;
+  cfg->overhead   = 0.0001;
+  cfg->cache_size = 16ULL << 20;
+  cfg->segments   = 16;
+  cfg->ahead      = 256 * 1024;
+}
+
+static bool parse_option(const char *key, const char *val, void *ctx)
+{
+  BusConfig *cfg = (BusConfig*)ctx;
+  char c;
+
+  if (strcmp(key, "link") == 0) {
+    for (size_t i=0; i<sizeof(links)/sizeof(links[0]); i++) {
+      if (strcmp(val, links[i].name) == 0) {
+        cfg->rate = links[i].mbs * 1e6;
+        return true;
+      }
+    }
+    double mbs;
+    if ((sscanf(val, "%lf%c", &mbs, &c) != 1) || !(mbs > 0.0)) return false;
+    cfg->rate = mbs * 1e6;
+    return true;
+  }
+  if (strcmp(key, "overhead") == 0) {
+    return (sscanf(val, "%lf%c", &cfg->overhead, &c) == 1) &&
+           (cfg->overhead >= 0.0);
+  }
+  if (strcmp(key, "cache") == 0) {
+    return parse_size(val, &cfg->cache_size);
+  }
+  if (strcmp(key, "segments") == 0) {
+    return (sscanf(val, "%u%c", &cfg->segments, &c) == 1) &&
+           (cfg->segments > 0);
+  }
+  if (strcmp(key, "ahead") == 0) {
+    return parse_size(val, &cfg->ahead);
+  }
+
+  return false;
+}
+
+bool bus_parse(const char *spec, BusConfig *cfg)
+{
+  return parse_options(spec, parse_option, cfg, "host interface");
+}
+
+
+//------------------------------------------------------------------------------
+// HostInterface
+//
+HostInterface::HostInterface(const BusConfig &cfg, uint32 sector_size,
+                             uint64 capacity)
+  : _cfg(cfg), _sector_size(sector_size), _capacity(capacity),
+    _segment_size(cfg.cache_size / cfg.segments),
+    _fs((int64)(1e15 / cfg.rate + 0.5)), _overhead(sim_time(cfg.overhead)),
+    _recent(0), _clock(0), _bus_free(0), _media_fs(0),
+    _reads(0), _hits(0), _writes(0), _bus_bound(0),
+    _bus_time(0), _overlap(0)
+{
+  Segment empty = { 0, 0, 0, 0, 0, 0 };
+  if (_segment_size >= sector_size) _seg.assign(cfg.segments, empty);
+}
+
+SimTime HostInterface::command(SimTime ts)
+{
+  return ts + _overhead;
+}
+
+bool HostInterface::hit(SimTime ts, uint64 address, uint64 size)
+{
+  _reads++;
+
+  uint64 end = address + size;
+  for (size_t i=0; i<_seg.size(); i++) {
+    Segment &s = _seg[i];
+    if ((address < s.lo) || (end > s.hi) || (size == 0)) continue;
+
+    // read-ahead data arrive at the media rate
+    SimTime ready = s.done;
+    if (end > s.mid) ready += (SimTime)((end - s.mid) * s.fs / 1000000);
+    if (ready > ts) continue;
+
+    s.used = ++_clock;
+    return true;
+  }
+  return false;
+}
+
+SimTime HostInterface::send(SimTime ts, uint64 bytes)
+{
+  SimTime start = ts > _bus_free ? ts : _bus_free;
+  _bus_time += xfer(bytes);
+  _bus_free = start + xfer(bytes);
+  return _bus_free;
+}
+
+SimTime HostInterface::transfer(SimTime ts, uint64 size)
+{
+  _hits++;
+  return send(ts, size);
+}
+
+void HostInterface::stream(SimTime from, SimTime to, uint64 bytes)
+{
+  // the transfer of the run cannot end before its last sector is read
+  SimTime end = send(from, bytes);
+  SimTime last = to + xfer(_sector_size);
+  if (end < last) _bus_free = last;
+  if ((to > from) && (bytes > 0)) _media_fs = (to - from) * 1000000 / bytes;
+}
+
+void HostInterface::invalidate(uint64 lo, uint64 hi)
+{
+  for (size_t i=0; i<_seg.size(); i++) {
+    Segment &s = _seg[i];
+    if ((s.lo < hi) && (lo < s.hi)) s.lo = s.mid = s.hi = 0;
+  }
+}
+
+uint32 HostInterface::victim(void) const
+{
+  uint32 v = 0;
+  for (uint32 i=1; i<_seg.size(); i++) {
+    if (_seg[i].used < _seg[v].used) v = i;
+  }
+  return v;
+}
+
+void HostInterface::stop_ahead(SimTime ts)
+{
+  Segment &prev = _seg[_recent];
+  if (prev.hi <= prev.mid) return;
+
+  uint64 got = ts > prev.done ? (uint64)((ts - prev.done) * 1000000 / prev.fs)
+                              : 0;
+  got -= got % _sector_size;
+  if (prev.mid + got < prev.hi) prev.hi = prev.mid + got;
+}
+
+SimTime HostInterface::read_done(SimTime start, SimTime media_end,
+                                 uint64 address, uint64 size)
+{
+  SimTime end = _bus_free > media_end ? _bus_free : media_end;
+  if (end > media_end + xfer(_sector_size)) _bus_bound++;
+  _overlap += xfer(size) - (end - media_end);
+  if (_seg.empty()) return end;
+
+  // this access stopped the read-ahead of the previous miss
+  stop_ahead(start);
+
+  // keep the end of the data and read ahead into the rest of the segment
+  uint64 hi = address + size;
+  invalidate(address, hi + _cfg.ahead);
+  _recent = victim();
+  Segment &s = _seg[_recent];
+  s.lo   = size > _segment_size ? hi - _segment_size : address;
+  s.mid  = hi;
+  s.hi   = hi + min(_cfg.ahead, _segment_size - (hi - s.lo));
+  if (s.hi > _capacity) s.hi = _capacity;
+  s.done = media_end;
+  s.fs   = _media_fs > 0 ? _media_fs : _fs;
+  s.used = ++_clock;
+
+  return end;
+}
+
+SimTime HostInterface::write_done(SimTime start, SimTime media_end,
+                                  uint64 address, uint64 size)
+{
+  _writes++;
+
+  SimTime bus_end = send(start, size);
+  SimTime end = bus_end > media_end ? bus_end : media_end;
+  if (bus_end > media_end) _bus_bound++;
+  _overlap += xfer(size) - (end - media_end);
+  if (_seg.empty()) return end;
+
+  // the write stopped any read-ahead; the written data stay in the buffer
+  stop_ahead(start);
+
+  uint64 hi = address + size;
+  invalidate(address, hi);
+  if (size > _segment_size) return end;
+  uint32 v = victim();
+  Segment &s = _seg[v];
+  s.lo   = address;
+  s.mid  = s.hi = hi;
+  s.done = end;
+  s.fs   = _fs;
+  s.used = ++_clock;
+
+  return end;
+}
+
+void HostInterface::save(Snapshot &s) const
+{
+  s.begin("bus");
+  s.put((uint64)_seg.size());
+  for (size_t i=0; i<_seg.size(); i++) {
+    s.put(_seg[i].lo);
+    s.put(_seg[i].mid);
+    s.put(_seg[i].hi);
+    s.put(_seg[i].done);
+    s.put(_seg[i].fs);
+    s.put(_seg[i].used);
+  }
+  s.put((uint64)_recent);
+  s.put(_clock);
+  s.put(_bus_free);
+  s.put(_media_fs);
+  s.put(_reads);
+  s.put(_hits);
+  s.put(_writes);
+  s.put(_bus_bound);
+  s.put(_bus_time);
+  s.put(_overlap);
+}
+
+bool HostInterface::restore(Snapshot &s)
+{
+  if (!s.expect("bus")) return false;
+  if (s.get_u64() != _seg.size()) {
+    cout << "snapshot with a different drive buffer" << endl;
+    return false;
+  }
+  for (size_t i=0; i<_seg.size(); i++) {
+    _seg[i].lo   = s.get_u64();
+    _seg[i].mid  = s.get_u64();
+    _seg[i].hi   = s.get_u64();
+    _seg[i].done = s.get_i64();
+    _seg[i].fs   = s.get_i64();
+    _seg[i].used = s.get_u64();
+  }
+  _recent     = (uint32)s.get_u64();
+  _clock      = s.get_u64();
+  _bus_free   = s.get_i64();
+  _media_fs   = s.get_i64();
+  _reads      = s.get_u64();
+  _hits       = s.get_u64();
+  _writes     = s.get_u64();
+  _bus_bound  = s.get_u64();
+  _bus_time   = s.get_i64();
+  _overlap    = s.get_i64();
+  return s.good() && (_recent < (_seg.empty() ? 1 : _seg.size()));
+}
+
+void HostInterface::print_stats(ostream &os) const
+{
+  uint64 misses = _reads - _hits + _writes;
+
+  os.precision(2);
+  os << "host interface: " << endl
+     << "  link:        " << dec << fixed << _cfg.rate / 1e6 << " MB/s, "
+     << "overhead " << setprecision(6) << _cfg.overhead << " s" << endl
+     << "  buffer:      " << _seg.size() << " segments of " << _segment_size
+     << " bytes, read-ahead " << _cfg.ahead << " bytes" << endl
+     << "  read hits:   " << _hits << " / " << _reads << " ("
+     << setprecision(2) << (_reads > 0 ? 100.0 * _hits / _reads : 0.0)
+     << "%)" << endl
+     << "  bus-bound:   " << _bus_bound << " / " << misses
+     << " media accesses" << endl
+     << "  bus busy:    " << setprecision(6) << sim_seconds(_bus_time)
+     << " s, " << sim_seconds(_overlap) << " s hidden behind media access"
+     << endl
+     << endl;
+}
@@ -0,0 +1,214 @@
+//------------------------------------------------------------------------------
+/// @brief host interface and drive buffer of an HDD
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_BUS_H__
+#define __CA_BUS_H__
+
+#include <iostream>
+#include <vector>
+
+#include "disk.h"
+using namespace std;
+
+//------------------------------------------------------------------------------
+/// @brief configuration of the host interface
+///
+/// A configuration is parsed from a comma-separated list of key=value pairs
+/// (sizes accept K, M, G suffixes):
+///
+/// - link=sata1|sata2|sata3|sas3|sas6|sas12|<MB/s>
+///                                  payload bandwidth of the link (the named
+///                                  links are 150, 300, 600, 300, 600, and
+///                                  1200 MB/s after 8b/10b encoding)
+/// - overhead=<seconds>             command processing time of the drive
+/// - cache=<bytes>                  size of the drive buffer (0: no hits)
+/// - segments=<n>                   number of buffer segments
+/// - ahead=<bytes>                  read-ahead after a read miss
+///
+typedef struct _bus_config {
+  double rate;                      ///< link bandwidth in bytes/s
+  double overhead;                  ///< command overhead in seconds
+  uint64 cache_size;                ///< drive buffer in bytes
+  uint32 segments;                  ///< buffer segments
+  uint64 ahead;                     ///< read-ahead in bytes
+} BusConfig;
+
+/// @brief initialize @a cfg with default values
+void bus_defaults(BusConfig *cfg);
+
+/// @brief parse @a spec into @a cfg (on top of the values already in @a cfg)
+/// @retval true if @a spec was parsed successfully, false otherwise
+bool bus_parse(const char *spec, BusConfig *cfg);
+
+
+//------------------------------------------------------------------------------
+/// @brief host interface and segmented buffer of an HDD
+///
+/// HostInterface adds the host side of an access to the mechanical timing
+/// of the HDD:
+///
+/// - every command costs BusConfig::overhead before the drive acts on it,
+/// - a read that is held completely by the drive buffer is served from the
+///   buffer: it costs the command overhead and the bus transfer only, so the
+///   link is the bottleneck,
+/// - a read miss streams the data to the host while it comes off the media;
+///   the transfer of a track run starts when its first sector is in the
+///   buffer and cannot overtake the media, so the read completes when the
+///   slower of the two has delivered the last sector,
+/// - a write is transferred to the buffer while the heads are positioned; it
+///   completes when the media write and the bus transfer have both ended
+///   (no write-back caching).
+///
+/// After a read miss the drive keeps reading up to BusConfig::ahead bytes
+/// into the segment. The read-ahead takes place while the drive is idle: it
+/// is not charged to later commands, but it is cut short by the next media
+/// access, and data become available only as fast as the media delivers
+/// them.
+///
+class HostInterface {
+  public:
+    /// @name constructor/destructor
+    /// @{
+
+    /// @brief constructor
+    /// @param cfg configuration
+    /// @param sector_size sector size of the drive
+    /// @param capacity capacity of the drive in bytes
+    HostInterface(const BusConfig &cfg, uint32 sector_size, uint64 capacity);
+
+    /// @}
+
+
+    /// @name access methods
+    /// @{
+
+    /// @brief a command arrives at @a ts
+    /// @retval time when the drive starts to process it
+    SimTime command(SimTime ts);
+
+    /// @brief check whether a read of @a size bytes at @a address can be
+    ///        served from the buffer at time @a ts
+    bool   hit(SimTime ts, uint64 address, uint64 size);
+
+    /// @brief serve a buffer hit of @a size bytes starting at @a ts
+    /// @retval completion time
+    SimTime transfer(SimTime ts, uint64 size);
+
+    /// @brief the media read @a bytes bytes of a read miss from @a from
+    ///        until @a to. Called once per track run, in order.
+    void   stream(SimTime from, SimTime to, uint64 bytes);
+
+    /// @brief a read miss of @a size bytes at @a address started at
+    ///        @a start (after the command overhead), the media read ended
+    ///        at @a media_end
+    /// @retval completion time
+    SimTime read_done(SimTime start, SimTime media_end, uint64 address,
+                      uint64 size);
+
+    /// @brief a write of @a size bytes at @a address started at @a start
+    ///        (after the command overhead), the media write ended at
+    ///        @a media_end
+    /// @retval completion time
+    SimTime write_done(SimTime start, SimTime media_end, uint64 address,
+                       uint64 size);
+
+    /// @brief save the state to snapshot @a s
+    void   save(Snapshot &s) const;
+
+    /// @brief restore the state from snapshot @a s
+    bool   restore(Snapshot &s);
+
+    /// @}
+
+
+    /// @name statistics
+    /// @{
+
+    /// @brief print the interface statistics to @a os
+    void   print_stats(ostream &os) const;
+
+    /// @}
+
+
+  protected:
+    /// @brief a buffer segment: [lo, mid) was requested, [mid, hi) is read
+    ///        ahead at @a fs femtoseconds per byte starting at @a done
+    typedef struct _segment {
+      uint64 lo;                    ///< first byte
+      uint64 mid;                   ///< end of the requested data
+      uint64 hi;                    ///< end of the read-ahead
+      SimTime done;                 ///< time the requested data are in
+      int64  fs;                    ///< media time per byte of the read-ahead
+      uint64 used;                  ///< last use (LRU)
+    } Segment;
+
+    BusConfig _cfg;                 ///< configuration
+    uint32 _sector_size;            ///< sector size
+    uint64 _capacity;               ///< capacity of the drive
+    uint64 _segment_size;           ///< bytes per segment
+    int64  _fs;                     ///< link time per byte (fs)
+    SimTime _overhead;              ///< command overhead
+    vector<Segment> _seg;           ///< buffer segments
+    uint32 _recent;                 ///< segment of the last read miss
+    uint64 _clock;                  ///< LRU clock
+    SimTime _bus_free;              ///< time the link becomes idle
+    int64  _media_fs;               ///< media time per byte of the last run
+
+    // statistics
+    uint64 _reads;                  ///< read commands
+    uint64 _hits;                   ///< reads served from the buffer
+    uint64 _writes;                 ///< write commands
+    uint64 _bus_bound;              ///< misses whose completion the bus set
+    SimTime _bus_time;              ///< time the link transferred data
+    SimTime _overlap;               ///< transfer time hidden behind the media
+
+    /// @brief time the link needs for @a bytes bytes
+    SimTime xfer(uint64 bytes) const
+    {
+      return (SimTime)((bytes * _fs + 500000) / 1000000);
+    }
+
+    /// @brief the bus transfers @a bytes bytes, not before @a ts
+    /// @retval end of the transfer
+    SimTime send(SimTime ts, uint64 bytes);
+
+    /// @brief a media access starting at @a ts stops the read-ahead
+    void   stop_ahead(SimTime ts);
+
+    /// @brief drop the parts of the buffer overlapping [@a lo, @a hi)
+    void   invalidate(uint64 lo, uint64 hi);
+
+    /// @brief least recently used segment
+    uint32 victim(void) const;
+};
+
+#endif // __CA_BUS_H__
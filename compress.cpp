@@ -0,0 +1,132 @@
+//------------------------------------------------------------------------------
+/// @brief bzip2 compression and reading of (compressed) files
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <cstring>
+#include <bzlib.h>
+
+#include <fstream>
+#include <sstream>
+
+#include "compress.h"
+using namespace std;
+
+#define BZ2_CHUNK (1U << 30)        ///< input passed to bzip2 at a time
+
+//------------------------------------------------------------------------------
+// bzip2
+//
+bool bz2_compress(const string &data, string *out)
+{
+  // the lengths are unsigned ints
+  if (data.size() > 0x7fffffffU) return false;
+
+  // bzip2 needs at most 1% plus 600 bytes more than the input
+  unsigned int len = (unsigned int)(data.size() + data.size() / 100 + 600);
+  out->resize(len);
+  int ret = BZ2_bzBuffToBuffCompress(&(*out)[0], &len,
+                                     const_cast<char*>(data.data()),
+                                     (unsigned int)data.size(), 9, 0, 0);
+  if (ret != BZ_OK) {
+    out->clear();
+    return false;
+  }
+  out->resize(len);
+  return true;
+}
+
+bool bz2_decompress(const string &data, string *out)
+{
+  // BZ2_bzBuffToBuffDecompress stops after the first stream and needs the
+  // size of the output; the stream interface handles both
+  bz_stream bz;
+  char buf[65536];
+  size_t pos = 0;
+
+  out->clear();
+  while (pos < data.size()) {
+    memset(&bz, 0, sizeof(bz));
+    if (BZ2_bzDecompressInit(&bz, 0, 0) != BZ_OK) return false;
+
+    int ret = BZ_OK;
+    while (ret == BZ_OK) {
+      if (bz.avail_in == 0) {
+        if (pos == data.size()) break;      // truncated stream
+        size_t n = data.size() - pos < BZ2_CHUNK ? data.size() - pos
+                                                  : BZ2_CHUNK;
+        bz.next_in  = const_cast<char*>(data.data() + pos);
+        bz.avail_in = (unsigned int)n;
+        pos += n;
+      }
+      bz.next_out  = buf;
+      bz.avail_out = sizeof(buf);
+      ret = BZ2_bzDecompress(&bz);
+      out->append(buf, sizeof(buf) - bz.avail_out);
+    }
+    pos -= bz.avail_in;                     // input after the stream
+    BZ2_bzDecompressEnd(&bz);
+    if (ret != BZ_STREAM_END) return false;
+  }
+  return true;
+}
+
+
+//------------------------------------------------------------------------------
+// files
+//
+bool read_range(const string &path, uint64 offset, uint64 length,
+                string *data)
+{
+  ifstream is(path.c_str(), ios::binary);
+  if (!is.good()) return false;
+
+  data->resize(length);
+  is.seekg(offset);
+  if (length > 0) is.read(&(*data)[0], length);
+  return is.good() && ((uint64)is.gcount() == length);
+}
+
+bool read_file(const string &path, string *data)
+{
+  ifstream is(path.c_str(), ios::binary);
+  if (!is.good()) return false;
+
+  ostringstream ss;
+  ss << is.rdbuf();
+  if (is.bad()) return false;
+
+  size_t n = path.size();
+  if ((n > 4) && (path.compare(n - 4, 4, ".bz2") == 0)) {
+    return bz2_decompress(ss.str(), data);
+  }
+  *data = ss.str();
+  return true;
+}
@@ -0,0 +1,59 @@
+//------------------------------------------------------------------------------
+/// @brief bzip2 compression and reading of (compressed) files
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_COMPRESS_H__
+#define __CA_COMPRESS_H__
+
+#include <string>
+
+#include "disk.h"
+using namespace std;
+
+/// @brief compress @a data into one bzip2 stream @a out
+/// @retval true on success, false otherwise
+bool bz2_compress(const string &data, string *out);
+
+/// @brief decompress the bzip2 streams in @a data (one or more, back to
+///        back) into @a out
+/// @retval true if @a data is a valid sequence of streams, false otherwise
+bool bz2_decompress(const string &data, string *out);
+
+/// @brief read @a length bytes at @a offset of the file @a path into @a data
+/// @retval true on success, false otherwise
+bool read_range(const string &path, uint64 offset, uint64 length,
+                string *data);
+
+/// @brief read the file @a path into @a data; .bz2 files are decompressed
+/// @retval true on success, false otherwise
+bool read_file(const string &path, string *data);
+
+#endif // __CA_COMPRESS_H__
@@ -0,0 +1,353 @@
+//------------------------------------------------------------------------------
+/// @brief batch address decoding kernels
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <cmath>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define DECODE_X86
+#include <immintrin.h>
+#endif
+
+#include "decode.h"
+#include "hdd.h"
+using namespace std;
+
+//------------------------------------------------------------------------------
+// All kernels use the same branchless search: the number of halving steps
+// depends only on the span of the buckets, so all lanes of a vector take the
+// same path. For a sector s, the search starts at the first track of the
+// bucket of s and finds the last track t with start[t] <= s. The position on
+// the track then follows from
+//
+//   off        = s - start[t]
+//   surface    = off / sectors[t]
+//   sector     = off - surface * sectors[t]
+//   max_access = surfaces * sectors[t] - off
+//
+// Divisions are done in double precision; the operands are below 2^52 (the
+// capacity of the disk must be, too), so the truncated quotients are exact.
+//
+
+//------------------------------------------------------------------------------
+// tables
+//
+void decode_init(DecodeTable *t, const vector<uint32> &sectors,
+                 uint32 surfaces, uint32 sector_size,
+                 vector<uint64> *start, vector<uint32> *bucket)
+{
+  uint32 tracks = (uint32)sectors.size();
+
+  // cumulative sector table
+  start->resize(tracks + 1);
+  uint64 total = 0;
+  for (uint32 i=0; i<tracks; i++) {
+    (*start)[i] = total;
+    total += (uint64)sectors[i] * surfaces;
+  }
+  (*start)[tracks] = total;
+
+  // about one bucket per track
+  uint32 shift = 0;
+  while ((total >> shift) > tracks) shift++;
+  uint64 buckets = (total >> shift) + 1;
+
+  bucket->resize(buckets);
+  uint32 span = 1, first = 0, last = 0;
+  for (uint64 b=0; b<buckets; b++) {
+    uint64 lo = b << shift, hi = ((b + 1) << shift) - 1;
+    while ((first + 1 < tracks) && ((*start)[first + 1] <= lo)) first++;
+    while ((last + 1 < tracks) && ((*start)[last + 1] <= hi)) last++;
+    (*bucket)[b] = first;
+    if (last - first + 1 > span) span = last - first + 1;
+  }
+
+  // the search may look at up to span-1 tracks past the last one
+  start->resize(tracks + span, total);
+
+  t->start       = &(*start)[0];
+  t->sectors     = &sectors[0];
+  t->bucket      = &(*bucket)[0];
+  t->shift       = shift;
+  t->span        = span;
+  t->tracks      = tracks;
+  t->surfaces    = surfaces;
+  t->sector_size = sector_size;
+  t->capacity    = total * sector_size;
+}
+
+
+//------------------------------------------------------------------------------
+// scalar kernel
+//
+bool decode_address(const DecodeTable *t, uint64 address, HDD_Position *pos)
+{
+  if (address >= t->capacity) {
+    pos->surface = pos->track = pos->sector = pos->max_access = 0;
+    return false;
+  }
+
+  uint64 s = address / t->sector_size;
+  uint32 base = t->bucket[s >> t->shift], len = t->span;
+  while (len > 1) {
+    uint32 half = len / 2;
+    base = t->start[base + half] <= s ? base + half : base;
+    len -= half;
+  }
+
+  uint32 off = (uint32)(s - t->start[base]);
+  uint32 n = t->sectors[base];
+  pos->surface    = off / n;
+  pos->track      = base;
+  pos->sector     = off - pos->surface * n;
+  pos->max_access = t->surfaces * n - off;
+  return true;
+}
+
+static size_t decode_scalar(const DecodeTable *t, const uint64 *address,
+                            size_t n, HDD_Position *pos)
+{
+  size_t valid = 0;
+  for (size_t i=0; i<n; i++) valid += decode_address(t, address[i], &pos[i]);
+  return valid;
+}
+
+
+//------------------------------------------------------------------------------
+// vector kernels
+//
+#ifdef DECODE_X86
+
+/// store four positions given as vectors of surfaces, tracks, sectors, and
+/// max_access (a 4x4 transpose)
+__attribute__((target("avx2")))
+static inline void store4(HDD_Position *pos, __m128i surface, __m128i track,
+                          __m128i sector, __m128i max_access)
+{
+  __m128i a = _mm_unpacklo_epi32(surface, track);
+  __m128i b = _mm_unpackhi_epi32(surface, track);
+  __m128i c = _mm_unpacklo_epi32(sector, max_access);
+  __m128i d = _mm_unpackhi_epi32(sector, max_access);
+  _mm_storeu_si128((__m128i*)&pos[0], _mm_unpacklo_epi64(a, c));
+  _mm_storeu_si128((__m128i*)&pos[1], _mm_unpackhi_epi64(a, c));
+  _mm_storeu_si128((__m128i*)&pos[2], _mm_unpacklo_epi64(b, d));
+  _mm_storeu_si128((__m128i*)&pos[3], _mm_unpackhi_epi64(b, d));
+}
+
+__attribute__((target("avx2")))
+static size_t decode_avx2(const DecodeTable *t, const uint64 *address,
+                          size_t n, HDD_Position *pos)
+{
+  const __m256i sign     = _mm256_set1_epi64x((long long)0x8000000000000000ULL);
+  const __m256i capacity = _mm256_set1_epi64x((long long)t->capacity);
+  const __m256i magic    = _mm256_set1_epi64x(0x4330000000000000LL);
+  const __m256d magic_d  = _mm256_set1_pd(4503599627370496.0);   // 2^52
+  const __m256d size_d   = _mm256_set1_pd(t->sector_size);
+  const __m128i surfaces = _mm_set1_epi32(t->surfaces);
+  const __m128i shift    = _mm_cvtsi32_si128(t->shift);
+  const __m256i lo32     = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+  const long long *start = (const long long*)t->start;
+  const int *sectors     = (const int*)t->sectors;
+  const int *bucket      = (const int*)t->bucket;
+
+  size_t valid = 0, i = 0;
+  for (; i+4<=n; i+=4) {
+    // invalid addresses are decoded as address 0 and masked at the end
+    __m256i a  = _mm256_loadu_si256((const __m256i*)&address[i]);
+    __m256i ok = _mm256_cmpgt_epi64(_mm256_xor_si256(capacity, sign),
+                                    _mm256_xor_si256(a, sign));
+    a = _mm256_and_si256(a, ok);
+
+    // sector = address / sector_size (a < 2^52: exact via the 2^52 trick)
+    __m256d ad = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(a, magic)),
+                               magic_d);
+    __m256d sd = _mm256_floor_pd(_mm256_div_pd(ad, size_d));
+    __m256i s  = _mm256_xor_si256(
+                   _mm256_castpd_si256(_mm256_add_pd(sd, magic_d)), magic);
+
+    // branchless search for the track
+    __m256i b    = _mm256_srl_epi64(s, shift);
+    __m256i base = _mm256_cvtepu32_epi64(_mm256_i64gather_epi32(bucket, b, 4));
+    uint32 len = t->span;
+    while (len > 1) {
+      uint32 half = len / 2;
+      __m256i idx = _mm256_add_epi64(base, _mm256_set1_epi64x(half));
+      __m256i v   = _mm256_i64gather_epi64(start, idx, 8);
+      base = _mm256_blendv_epi8(idx, base, _mm256_cmpgt_epi64(v, s));
+      len -= half;
+    }
+
+    // position on the track (32-bit lanes from here on)
+    __m256i first = _mm256_i64gather_epi64(start, base, 8);
+    __m128i track = _mm256_castsi256_si128(
+                      _mm256_permutevar8x32_epi32(base, lo32));
+    __m128i off   = _mm256_castsi256_si128(
+                      _mm256_permutevar8x32_epi32(_mm256_sub_epi64(s, first),
+                                                  lo32));
+    __m128i nsec  = _mm256_i64gather_epi32(sectors, base, 4);
+    __m128i surf  = _mm256_cvttpd_epi32(_mm256_floor_pd(
+                      _mm256_div_pd(_mm256_cvtepi32_pd(off),
+                                    _mm256_cvtepi32_pd(nsec))));
+    __m128i sec   = _mm_sub_epi32(off, _mm_mullo_epi32(surf, nsec));
+    __m128i max   = _mm_sub_epi32(_mm_mullo_epi32(surfaces, nsec), off);
+
+    __m128i mask  = _mm256_castsi256_si128(
+                      _mm256_permutevar8x32_epi32(ok, lo32));
+    store4(&pos[i], _mm_and_si128(surf, mask), _mm_and_si128(track, mask),
+           _mm_and_si128(sec, mask), _mm_and_si128(max, mask));
+    valid += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(mask)));
+  }
+
+  return valid + decode_scalar(t, &address[i], n - i, &pos[i]);
+}
+
+// GCC 12 reports the self-initialized _mm512_undefined_*() operands of the
+// AVX-512 intrinsics as maybe uninitialized once they are inlined (-O2)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+__attribute__((target("avx512f,avx512dq,avx2")))
+static size_t decode_avx512(const DecodeTable *t, const uint64 *address,
+                            size_t n, HDD_Position *pos)
+{
+  const __m512i capacity = _mm512_set1_epi64((long long)t->capacity);
+  const __m512d size_d   = _mm512_set1_pd(t->sector_size);
+  const __m256i surfaces = _mm256_set1_epi32(t->surfaces);
+  const __m512i ones     = _mm512_set1_epi64(-1);
+  const __m128i shift    = _mm_cvtsi32_si128(t->shift);
+  const long long *start = (const long long*)t->start;
+  const int *sectors     = (const int*)t->sectors;
+  const int *bucket      = (const int*)t->bucket;
+
+  size_t valid = 0, i = 0;
+  for (; i+8<=n; i+=8) {
+    // invalid addresses are decoded as address 0 and masked at the end
+    __m512i a    = _mm512_loadu_si512((const void*)&address[i]);
+    __mmask8 ok  = _mm512_cmplt_epu64_mask(a, capacity);
+    a = _mm512_maskz_mov_epi64(ok, a);
+
+    // sector = address / sector_size
+    __m512d sd = _mm512_roundscale_pd(
+                   _mm512_div_pd(_mm512_cvtepu64_pd(a), size_d),
+                   _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+    __m512i s  = _mm512_cvttpd_epu64(sd);
+
+    // branchless search for the track
+    __m512i b    = _mm512_srl_epi64(s, shift);
+    __m512i base = _mm512_cvtepu32_epi64(_mm512_i64gather_epi32(b, bucket, 4));
+    uint32 len = t->span;
+    while (len > 1) {
+      uint32 half = len / 2;
+      __m512i idx = _mm512_add_epi64(base, _mm512_set1_epi64(half));
+      __m512i v   = _mm512_i64gather_epi64(idx, start, 8);
+      base = _mm512_mask_blend_epi64(_mm512_cmpgt_epu64_mask(v, s), idx, base);
+      len -= half;
+    }
+
+    // position on the track (32-bit lanes from here on)
+    __m512i first = _mm512_i64gather_epi64(base, start, 8);
+    __m256i track = _mm512_cvtepi64_epi32(base);
+    __m256i off   = _mm512_cvtepi64_epi32(_mm512_sub_epi64(s, first));
+    __m256i nsec  = _mm512_i64gather_epi32(base, sectors, 4);
+    __m256i surf  = _mm512_cvttpd_epi32(_mm512_roundscale_pd(
+                      _mm512_div_pd(_mm512_cvtepi32_pd(off),
+                                    _mm512_cvtepi32_pd(nsec)),
+                      _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC));
+    __m256i sec   = _mm256_sub_epi32(off, _mm256_mullo_epi32(surf, nsec));
+    __m256i max   = _mm256_sub_epi32(_mm256_mullo_epi32(surfaces, nsec), off);
+
+    __m256i mask  = _mm512_cvtepi64_epi32(_mm512_maskz_mov_epi64(ok, ones));
+    surf  = _mm256_and_si256(surf, mask);
+    track = _mm256_and_si256(track, mask);
+    sec   = _mm256_and_si256(sec, mask);
+    max   = _mm256_and_si256(max, mask);
+    store4(&pos[i], _mm256_castsi256_si128(surf), _mm256_castsi256_si128(track),
+           _mm256_castsi256_si128(sec), _mm256_castsi256_si128(max));
+    store4(&pos[i+4], _mm256_extracti128_si256(surf, 1),
+           _mm256_extracti128_si256(track, 1), _mm256_extracti128_si256(sec, 1),
+           _mm256_extracti128_si256(max, 1));
+    valid += __builtin_popcount(ok);
+  }
+
+  return valid + decode_scalar(t, &address[i], n - i, &pos[i]);
+}
+#pragma GCC diagnostic pop
+#endif
+
+
+//------------------------------------------------------------------------------
+// kernel selection
+//
+bool decode_supported(DecodeIsa isa)
+{
+  switch (isa) {
+    case DECODE_SCALAR:
+    case DECODE_AUTO:
+      return true;
+#ifdef DECODE_X86
+    case DECODE_AVX2:
+      return __builtin_cpu_supports("avx2");
+    case DECODE_AVX512:
+      return __builtin_cpu_supports("avx512f") &&
+             __builtin_cpu_supports("avx512dq") &&
+             __builtin_cpu_supports("avx2");
+#endif
+    default:
+      return false;
+  }
+}
+
+DecodeKernel decode_kernel(DecodeIsa isa)
+{
+  if (isa == DECODE_AUTO) {
+    if (decode_supported(DECODE_AVX512)) isa = DECODE_AVX512;
+    else if (decode_supported(DECODE_AVX2)) isa = DECODE_AVX2;
+    else isa = DECODE_SCALAR;
+  }
+  if (!decode_supported(isa)) return NULL;
+
+  switch (isa) {
+#ifdef DECODE_X86
+    case DECODE_AVX2:   return decode_avx2;
+    case DECODE_AVX512: return decode_avx512;
+#endif
+    default:            return decode_scalar;
+  }
+}
+
+const char *decode_name(DecodeIsa isa)
+{
+  switch (isa) {
+    case DECODE_SCALAR: return "scalar";
+    case DECODE_AVX2:   return "avx2";
+    case DECODE_AVX512: return "avx512";
+    default:            return "auto";
+  }
+}
@@ -0,0 +1,103 @@
+//------------------------------------------------------------------------------
+/// @brief batch address decoding kernels
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_DECODE_H__
+#define __CA_DECODE_H__
+
+#include <cstddef>
+#include <vector>
+
+#include "disk.h"
+using namespace std;
+
+struct _hdd_pos;
+
+//------------------------------------------------------------------------------
+/// @brief geometry tables for address decoding
+///
+/// Addresses are laid out track by track; a track spans all surfaces. The
+/// table holds the first sector of every track (the cumulative sector
+/// table) and the sectors per track and surface. A coarse index maps each
+/// bucket of 2^shift sectors to the first track it touches, so a lookup only
+/// searches the @a span tracks a bucket can cover. The arrays are owned by
+/// the caller (see decode_init()).
+///
+typedef struct _decode_table {
+  const uint64 *start;              ///< first sector of each track, padded
+                                    ///< with the total up to tracks+span
+  const uint32 *sectors;            ///< sectors per track on one surface
+  const uint32 *bucket;             ///< first track of each bucket
+  uint32 shift;                     ///< log2 of the sectors per bucket
+  uint32 span;                      ///< most tracks touched by a bucket
+  uint32 tracks;                    ///< number of tracks per surface
+  uint32 surfaces;                  ///< number of surfaces
+  uint32 sector_size;               ///< bytes per sector
+  uint64 capacity;                  ///< capacity in bytes
+} DecodeTable;
+
+/// @brief build the tables of @a t for a disk with @a surfaces surfaces of
+///        @a sectors[i] sectors on track i, stored in @a start and @a bucket
+void decode_init(DecodeTable *t, const vector<uint32> &sectors,
+                 uint32 surfaces, uint32 sector_size,
+                 vector<uint64> *start, vector<uint32> *bucket);
+
+/// @brief translate the byte address @a address into position @a pos
+/// @retval true if @a address is valid, false otherwise (@a pos is zeroed)
+bool decode_address(const DecodeTable *t, uint64 address, struct _hdd_pos *pos);
+
+/// @brief instruction sets of the decode kernels
+typedef enum {
+  DECODE_SCALAR,                    ///< portable C++
+  DECODE_AVX2,                      ///< 4 addresses per step
+  DECODE_AVX512,                    ///< 8 addresses per step (AVX-512F/DQ)
+  DECODE_AUTO,                      ///< best kernel supported by the CPU
+} DecodeIsa;
+
+/// @brief translate the byte addresses @a address[0..n) into positions
+///        @a pos[0..n). Positions of invalid addresses (beyond the capacity)
+///        are all zero; valid positions have a non-zero max_access.
+/// @retval number of valid addresses
+typedef size_t (*DecodeKernel)(const DecodeTable *t, const uint64 *address,
+                               size_t n, struct _hdd_pos *pos);
+
+/// @brief true if the CPU supports the kernel for @a isa
+bool decode_supported(DecodeIsa isa);
+
+/// @brief the kernel for @a isa; DECODE_AUTO selects the best kernel
+///        supported by the CPU at run time. Returns NULL if @a isa is not
+///        supported.
+DecodeKernel decode_kernel(DecodeIsa isa=DECODE_AUTO);
+
+/// @brief name of @a isa
+const char *decode_name(DecodeIsa isa);
+
+#endif // __CA_DECODE_H__
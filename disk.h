@@ -39,6 +39,29 @@ typedef unsigned long long uint64;        ///< 64-bit unsigned int
 typedef          long long  int64;        ///< 64-bit signed int
 typedef unsigned int       uint32;        ///< 32-bit unsigned int
 typedef          int        int32;        ///< 32-bit signed int
+typedef unsigned char      uint8;         ///< 8-bit unsigned int
+
+//------------------------------------------------------------------------------
+// simulated time
+//
+// The simulation runs on an integer nanosecond clock relative to the start of
+// the workload; seconds (double) are used only for input and output.
+
+/// @brief simulated time in nanoseconds
+typedef int64 SimTime;
+
+#define SIM_SECOND 1000000000LL           ///< nanoseconds per second
+
+/// @brief convert @a s seconds to simulated time (rounded to nanoseconds)
+inline SimTime sim_time(double s)
+{
+  return (SimTime)(s * SIM_SECOND + (s < 0.0 ? -0.5 : 0.5));
+}
+
+/// @brief convert the simulated time @a t to seconds
+inline double sim_seconds(SimTime t) { return (double)t / SIM_SECOND; }
+
+class Snapshot;
 
 //------------------------------------------------------------------------------
 /// @brief base class for disk-based storage devices
@@ -68,14 +91,37 @@ class Disk {
     /// @param adr starting address (in bytes) of data to read
     /// @param size number of bytes to read
     /// @retval time when the access ends (ts + latency of access)
-    virtual double read(double time, uint64 adr, uint64 size) = 0;
+    virtual SimTime read(SimTime time, uint64 adr, uint64 size) = 0;
 
     /// @brief write @a size bytes to @a adr
     /// @param time time of the event
     /// @param adr starting address (in bytes) of data to write
     /// @param size number of bytes to write
     /// @retval time when the access ends (ts + latency of access)
-    virtual double write(double time, uint64 adr, uint64 size) = 0;
+    virtual SimTime write(SimTime time, uint64 adr, uint64 size) = 0;
+
+    /// @brief update the state of the disk for an access of @a size bytes at
+    ///        @a adr without simulating its timing (fast-forward). Disks
+    ///        whose state is re-established by the next access need not
+    ///        implement it.
+    /// @param time time of the event
+    /// @param rw 'r' for reads, 'w' for writes
+    /// @param adr starting address (in bytes) of the access
+    /// @param size number of bytes accessed
+    virtual void warm(SimTime time, char rw, uint64 adr, uint64 size) {};
+
+    /// @}
+
+
+    /// @name snapshots
+    /// @{
+
+    /// @brief save the state of the disk to snapshot @a s
+    virtual void save(Snapshot &s) const {};
+
+    /// @brief restore the state of the disk from snapshot @a s
+    /// @retval true if the state was restored successfully
+    virtual bool restore(Snapshot &s) { return true; };
 
     /// @}
 };
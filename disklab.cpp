@@ -0,0 +1,204 @@
+//------------------------------------------------------------------------------
+/// @brief C interface of the disk simulator library
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <cmath>
+#include <cstring>
+#include <new>
+
+#include "disklab.h"
+#include "hdd.h"
+#include "replay.h"
+using namespace std;
+
+//------------------------------------------------------------------------------
+// dl_hdd
+//
+// No C++ exception may leave the entry points: allocation failures are
+// reported as a NULL handle, a NaN completion time, or a short batch.
+// Requests are validated here, so the HDD never reports an invalid
+// parameter on the stdout of the host program.
+//
+#define DL_PREFETCH 256             ///< requests decoded ahead in a batch
+
+struct dl_hdd {
+  HDD    *hdd;                      ///< simulated HDD
+  Replay *replay;                   ///< request queue and statistics
+  double  origin;                   ///< whole second of the first request
+  bool    started;                  ///< origin has been set
+};
+
+/// @brief convert the host timestamp @a ts to simulation time of @a hdd
+static SimTime dl_time(dl_hdd *hdd, double ts)
+{
+  if (!hdd->started) {
+    hdd->origin  = floor(ts);
+    hdd->started = true;
+  }
+  return sim_time(ts - hdd->origin);
+}
+
+/// @brief check that request @a rw, @a address, @a size fits on @a hdd
+static bool dl_valid(const dl_hdd *hdd, uint32_t rw, uint64_t address,
+                     uint64_t size)
+{
+  uint64 capacity = hdd->hdd->capacity();
+
+  if ((rw != DL_READ) && (rw != DL_WRITE)) return false;
+  return (size <= capacity) && (address <= capacity - size);
+}
+
+uint32_t dl_abi_version(void)
+{
+  return DL_ABI_VERSION;
+}
+
+dl_hdd *dl_hdd_create(const dl_geometry *geo)
+{
+  if ((geo == NULL) || (geo->surfaces == 0) || (geo->tracks_per_surface < 2) ||
+      (geo->sectors_innermost_track == 0) ||
+      (geo->sectors_outermost_track < geo->sectors_innermost_track) ||
+      (geo->rpm == 0) || (geo->sector_size == 0)) {
+    return NULL;
+  }
+
+  dl_hdd *h = new (nothrow) dl_hdd;
+  if (h == NULL) return NULL;
+  h->hdd     = NULL;
+  h->replay  = NULL;
+  h->origin  = 0.0;
+  h->started = false;
+
+  try {
+    h->hdd = new HDD(geo->surfaces, geo->tracks_per_surface,
+                     geo->sectors_innermost_track, geo->sectors_outermost_track,
+                     geo->rpm, geo->sector_size,
+                     geo->seek_overhead, geo->seek_per_track);
+    h->replay = new Replay(h->hdd);
+  } catch (...) {
+    dl_hdd_destroy(h);
+    return NULL;
+  }
+  return h;
+}
+
+void dl_hdd_destroy(dl_hdd *hdd)
+{
+  if (hdd == NULL) return;
+
+  delete hdd->replay;
+  delete hdd->hdd;
+  delete hdd;
+}
+
+uint64_t dl_hdd_capacity(const dl_hdd *hdd)
+{
+  return hdd->hdd->capacity();
+}
+
+double dl_hdd_submit(dl_hdd *hdd, double ts, uint32_t rw,
+                     uint64_t address, uint64_t size)
+{
+  if (!dl_valid(hdd, rw, address, size)) return NAN;
+
+  Request req;
+  req.ts      = dl_time(hdd, ts);
+  req.rw      = rw == DL_WRITE ? 'w' : 'r';
+  req.address = address;
+  req.size    = size;
+
+  try {
+    return hdd->origin + sim_seconds(hdd->replay->submit(req, req.ts));
+  } catch (...) {
+    return NAN;
+  }
+}
+
+size_t dl_hdd_submit_batch(dl_hdd *hdd, dl_request *req, size_t n)
+{
+  Request r;
+  uint64 address[DL_PREFETCH];
+
+  for (size_t i=0; i<n; i++) {
+    if (req[i].reserved != 0) return i;
+    if (!dl_valid(hdd, req[i].rw, req[i].address, req[i].size)) return i;
+
+    // decode the first sectors of the next requests in one pass
+    if (i % DL_PREFETCH == 0) {
+      size_t m = n - i < DL_PREFETCH ? n - i : DL_PREFETCH;
+      for (size_t j=0; j<m; j++) address[j] = req[i + j].address;
+      try {
+        hdd->hdd->prefetch(address, m);
+      } catch (...) {
+        return i;
+      }
+    }
+
+    r.ts      = dl_time(hdd, req[i].ts);
+    r.rw      = req[i].rw == DL_WRITE ? 'w' : 'r';
+    r.address = req[i].address;
+    r.size    = req[i].size;
+    try {
+      req[i].completion = hdd->origin +
+                          sim_seconds(hdd->replay->submit(r, r.ts));
+    } catch (...) {
+      return i;
+    }
+  }
+  return n;
+}
+
+void dl_hdd_stats(const dl_hdd *hdd, dl_stats *stats)
+{
+  const Replay *r = hdd->replay;
+
+  memset(stats, 0, sizeof(*stats));
+  try {
+    stats->reads         = r->reads();
+    stats->writes        = r->writes();
+    stats->bytes         = r->bytes();
+    stats->elapsed       = r->elapsed();
+    stats->iops          = r->iops();
+    stats->service_mean  = r->service().mean();
+    stats->service_p99   = r->service().percentile(99.0);
+    stats->response_mean = r->response().mean();
+    stats->response_p50  = r->response().percentile(50.0);
+    stats->response_p99  = r->response().percentile(99.0);
+    stats->response_max  = r->response().max();
+  } catch (...) {
+    memset(stats, 0, sizeof(*stats));
+  }
+}
+
+void dl_hdd_reset_stats(dl_hdd *hdd)
+{
+  hdd->replay->reset();
+}
@@ -0,0 +1,144 @@
+//------------------------------------------------------------------------------
+/// @brief C interface of the disk simulator library
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_DISKLAB_H__
+#define __CA_DISKLAB_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// @brief version of the C interface. Incremented on incompatible changes.
+#define DL_ABI_VERSION 1
+
+/// @brief marks the entry points of the library; all other symbols are
+///        hidden in libdisklab.so (built with -fvisibility=hidden)
+#if defined(__GNUC__)
+#define DL_EXPORT __attribute__((visibility("default")))
+#else
+#define DL_EXPORT
+#endif
+
+/// @brief request types
+#define DL_READ  0                  ///< read request
+#define DL_WRITE 1                  ///< write request
+
+/// @brief opaque handle to a simulated HDD
+typedef struct dl_hdd dl_hdd;
+
+/// @brief HDD geometry (same parameters as the header of a trace file)
+typedef struct dl_geometry {
+  uint32_t surfaces;                ///< number of surfaces
+  uint32_t tracks_per_surface;      ///< number of tracks per surface (>= 2)
+  uint32_t sectors_innermost_track; ///< sectors on the innermost track
+  uint32_t sectors_outermost_track; ///< sectors on the outermost track
+  uint32_t rpm;                     ///< rotations per minute
+  uint32_t sector_size;             ///< number of bytes per sector
+  double   seek_overhead;           ///< seek overhead (seconds)
+  double   seek_per_track;          ///< seek time per track (seconds)
+} dl_geometry;
+
+/// @brief a request for batch submission
+typedef struct dl_request {
+  double   ts;                      ///< arrival time (seconds)
+  uint32_t rw;                      ///< DL_READ or DL_WRITE
+  uint32_t reserved;                ///< must be zero
+  uint64_t address;                 ///< starting address (in bytes)
+  uint64_t size;                    ///< number of bytes
+  double   completion;              ///< (output) completion time
+} dl_request;
+
+/// @brief statistics of a simulated HDD
+typedef struct dl_stats {
+  uint64_t reads;                   ///< number of reads
+  uint64_t writes;                  ///< number of writes
+  uint64_t bytes;                   ///< number of bytes transferred
+  double   elapsed;                 ///< first arrival to last completion
+  double   iops;                    ///< requests per second
+  double   service_mean;            ///< mean service time
+  double   service_p99;             ///< 99th percentile of the service time
+  double   response_mean;           ///< mean response time
+  double   response_p50;            ///< median response time
+  double   response_p99;            ///< 99th percentile of the response time
+  double   response_max;            ///< maximal response time
+} dl_stats;
+
+/// @brief version of the library (DL_ABI_VERSION it was built with)
+DL_EXPORT uint32_t dl_abi_version(void);
+
+/// @brief create a simulated HDD
+/// @param geo geometry of the HDD
+/// @retval handle of the HDD, NULL if @a geo is invalid or out of memory
+DL_EXPORT dl_hdd  *dl_hdd_create(const dl_geometry *geo);
+
+/// @brief destroy HDD @a hdd
+DL_EXPORT void     dl_hdd_destroy(dl_hdd *hdd);
+
+/// @brief capacity of @a hdd in bytes
+DL_EXPORT uint64_t dl_hdd_capacity(const dl_hdd *hdd);
+
+/// @brief submit a single request to @a hdd
+///
+/// Requests are served one at a time in the order of submission; a request
+/// arriving while the disk is busy waits for the previous one to complete.
+///
+/// @param hdd HDD
+/// @param ts arrival time of the request
+/// @param rw DL_READ or DL_WRITE
+/// @param address starting address (in bytes)
+/// @param size number of bytes
+/// @retval time when the request completes, NaN if it cannot be served
+///         (@a rw invalid or the request extends past the capacity)
+DL_EXPORT double   dl_hdd_submit(dl_hdd *hdd, double ts, uint32_t rw,
+                                 uint64_t address, uint64_t size);
+
+/// @brief submit @a n requests to @a hdd. Sets the completion time of each.
+///        Stops at the first request that has a non-zero reserved field or
+///        cannot be served.
+/// @retval number of requests served
+DL_EXPORT size_t   dl_hdd_submit_batch(dl_hdd *hdd, dl_request *req, size_t n);
+
+/// @brief read the statistics of @a hdd into @a stats (all zero if out of
+///        memory)
+DL_EXPORT void     dl_hdd_stats(const dl_hdd *hdd, dl_stats *stats);
+
+/// @brief clear the statistics of @a hdd. The head position is kept.
+DL_EXPORT void     dl_hdd_reset_stats(dl_hdd *hdd);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __CA_DISKLAB_H__
@@ -1,12 +1,305 @@
 #include <cassert>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <ctime>
 #include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <unistd.h>
 
+#include "blocklayer.h"
 #include "disk.h"
+#include "heatmap.h"
 #include "hdd.h"
+#include "hybrid.h"
+#include "mrc.h"
+#include "remap.h"
+#include "replay.h"
+#include "sample.h"
+#include "service.h"
+#include "smr.h"
+#include "snapshot.h"
+#include "sweep.h"
+#include "tenant.h"
+#include "traceindex.h"
+#include "tracing.h"
+#include "workload.h"
 using namespace std;
 
-int main(void)
+static bool parse_depths(const char *spec, vector<uint32> *depths)
+{
+  const char *p = spec;
+  while (*p) {
+    char *end;
+    unsigned long d = strtoul(p, &end, 10);
+    if (end == p || d == 0) return false;
+    depths->push_back((uint32)d);
+    p = *end == ',' ? end+1 : end;
+    if (*end != ',' && *end != '\0') return false;
+  }
+  return !depths->empty();
+}
+
+/// closed-loop replay of @a wl at each of the I/O depths in @a depths
+static void sweep_depths(HDD *hdd, Workload *wl, const vector<uint32> &depths,
+                         Scheduler sched)
+{
+  MemoryWorkload trace(wl);
+
+  cout << "closed-loop replay (" << (sched == QUEUE_SSTF ? "sstf" : "fifo")
+       << ", " << trace.size() << " requests):" << endl
+       << "  iodepth        iops       MB/s    svc mean    lat mean     lat p50"
+       << "     lat p99" << endl;
+
+  for (size_t i=0; i<depths.size(); i++) {
+    Replay replay(hdd, sched);
+    trace.rewind();
+    replay.run_closed(&trace, depths[i]);
+
+    double mbs = 0.0;
+    if (replay.elapsed() > 0.0) {
+      mbs = replay.bytes() / replay.elapsed() / 1e6;
+    }
+
+    cout.precision(6);
+    cout << "  " << setw(7) << depths[i]
+         << dec << fixed
+         << setw(12) << setprecision(2) << replay.iops()
+         << setw(11) << setprecision(3) << mbs
+         << setprecision(6)
+         << setw(12) << replay.service().mean()
+         << setw(12) << replay.response().mean()
+         << setw(12) << replay.response().percentile(50.0)
+         << setw(12) << replay.response().percentile(99.0)
+         << endl;
+  }
+  cout << endl;
+}
+
+/// open-loop replay of @a wl on @a hdd and on @a other (named @a name)
+static void compare(HDD *hdd, Disk *other, const char *name, Workload *wl)
+{
+  MemoryWorkload trace(wl);
+
+  Replay base(hdd), alt(other);
+  base.run_open(&trace);
+  trace.rewind();
+  alt.run_open(&trace);
+
+  cout << "HDD" << endl;
+  base.report(cout);
+  cout << name << endl;
+  alt.report(cout);
+
+  double b = base.response().mean(), a = alt.response().mean();
+  cout.precision(6);
+  cout << "response time: mean " << dec << fixed << b << " -> " << a
+       << setprecision(2) << " (" << showpos
+       << (b > 0.0 ? 100.0 * (a - b) / b : 0.0) << noshowpos << "%), "
+       << "p99 " << setprecision(6) << base.response().percentile(99.0)
+       << " -> " << alt.response().percentile(99.0) << endl << endl;
+}
+
+/// wall-clock time in seconds
+static double wall_time(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/// split "<every>:<path>" into the checkpoint interval and the path
+static bool parse_checkpoint(const char *spec, uint64 *every, string *path)
+{
+  char *end;
+  *every = strtoull(spec, &end, 10);
+  if ((*every == 0) || (*end != ':') || (end[1] == '\0')) return false;
+  *path = end + 1;
+  return true;
+}
+
+/// print the trace time @a origin + @a t in seconds with six decimals
+static void print_time(ostream &os, int64 origin, SimTime t)
+{
+  SimTime us = (t + 500) / 1000;
+  int64 sec = origin + us / 1000000;
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%lld.%06lld", (long long)sec,
+           (long long)(us % 1000000));
+  os << buf;
+}
+
+/// write a snapshot of @a disk and @a wl to @a path
+static bool checkpoint(const char *path, const Disk *disk, const Workload *wl)
+{
+  Snapshot s;
+  if (!s.create(path)) return false;
+  disk->save(s);
+  wl->save(s);
+  return s.close();
+}
+
+/// restore @a disk and @a wl from the snapshot @a path
+static bool resume(const char *path, Disk *disk, Workload *wl)
+{
+  Snapshot s;
+  if (!s.open(path)) return false;
+  if (!disk->restore(s) || !wl->restore(s) || !s.close()) {
+    cout << "cannot restore from snapshot '" << path << "'" << endl;
+    return false;
+  }
+  return true;
+}
+
+/// open-loop replay of @a wl on @a hdd and through a block layer on @a other
+static void compare_block(HDD *hdd, Disk *other, const BlockConfig &cfg,
+                          Workload *wl)
+{
+  MemoryWorkload trace(wl);
+
+  Replay base(hdd);
+  BlockLayer block(other, cfg);
+  base.run_open(&trace);
+  trace.rewind();
+  block.run(&trace);
+
+  cout << "HDD" << endl;
+  base.report(cout);
+  cout << "HDD with block layer" << endl;
+  block.report(cout);
+
+  double bu = base.elapsed() > 0.0 ? base.service().sum() / base.elapsed()
+                                   : 0.0;
+  double au = block.elapsed() > 0.0 ? block.service().sum() / block.elapsed()
+                                    : 0.0;
+  double bm = base.elapsed() > 0.0 ? base.bytes() / base.elapsed() / 1e6 : 0.0;
+  double am = block.elapsed() > 0.0 ? block.bytes() / block.elapsed() / 1e6
+                                    : 0.0;
+  double b = base.response().mean(), a = block.response().mean();
+  cout.precision(6);
+  cout << "commands: " << base.requests() << " -> " << block.commands()
+       << " (merge ratio " << setprecision(3) << block.merge_ratio() << ")"
+       << endl
+       << "MB/s: " << bm << " -> " << am << ", utilization: " << bu << " -> "
+       << au << endl
+       << "response time: mean " << setprecision(6) << b << " -> " << a
+       << setprecision(2) << " (" << showpos
+       << (b > 0.0 ? 100.0 * (a - b) / b : 0.0) << noshowpos << "%), "
+       << "p99 " << setprecision(6) << base.response().percentile(99.0)
+       << " -> " << block.response().percentile(99.0) << endl << endl;
+}
+
+/// report and write the heatmap of @a hdd and the trace (if enabled) and
+/// delete @a hdd
+static int finish(HDD *hdd)
+{
+  bool ok = true;
+  if (hdd->heatmap()) {
+    hdd->heatmap()->print(cout);
+    ok = hdd->heatmap()->write();
+  }
+  ok = trace_close() && ok;
+
+  delete hdd;
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static void usage(const char *prog)
+{
+  cout << "Usage: " << prog << " [options] < trace" << endl
+       << endl
+       << "The HDD parameters are read from stdin, followed by the trace unless"
+       << endl
+       << "a synthetic workload or tenant traces are selected." << endl
+       << endl
+       << "Options:" << endl
+       << "  -g <spec>   replay a synthetic workload (see workload.h), "
+          "e.g." << endl
+       << "              "
+          "pattern=zipf,read=0.7,arrival=poisson:150,n=100000" << endl
+       << "  -q <depths> closed-loop replay at each of the given I/O depths, "
+          "e.g." << endl
+       << "              1,2,4,8,16,32 (timestamps of the trace are "
+          "ignored)" << endl
+       << "  -s <sched>  scheduler for outstanding requests: fifo (default), "
+          "sstf" << endl
+       << "  -c <spec>   compare the HDD with and without a flash cache (see"
+       << endl
+       << "              hybrid.h), e.g. "
+          "size=1G,admit=second,evict=arc,write=wb" << endl
+       << "  -z <spec>   compare the HDD with a shingled (SMR) HDD (see smr.h),"
+       << endl
+       << "              e.g. mode=dm,zone=4,mc=1G,idle=1" << endl
+       << "  -P <spec>   compare the HDD with and without idle power states "
+          "(see" << endl
+       << "              power.h), e.g. unload=0.5:0.05,lowrpm=5:1,standby=off"
+       << endl
+       << "  -F <spec>   sampled replay of the trace or the -g workload on the "
+          "HDD" << endl
+       << "              or the -c hybrid disk (see sample.h), e.g."
+       << endl
+       << "              period=10000,window=500,warmup=100,full=1" << endl
+       << "  -B <spec>   compare the HDD with and without a block layer that"
+       << endl
+       << "              merges and splits requests (see blocklayer.h), e.g."
+       << endl
+       << "              plug=0.002,max=512K" << endl
+       << "  -H <spec>   record where the accesses of the HDD land (see "
+          "heatmap.h)," << endl
+       << "              e.g. zones=100,interval=60,out=heat" << endl
+       << "  -O <spec>   compare the HDD with and without relocation of the hot"
+       << endl
+       << "              extents to the outer tracks (see remap.h), e.g."
+       << endl
+       << "              extent=1M,hot=1G,order=heat,train=0.5" << endl
+       << "  -I <spec>   compare the HDD with and without a model of the host"
+       << endl
+       << "              link and the drive buffer (see bus.h), e.g."
+       << endl
+       << "              link=sata2,overhead=0.0002,cache=8M,ahead=512K" << endl
+       << "  -T <spec>   replay several traces concurrently with fair-share"
+       << endl
+       << "              scheduling (see tenant.h), e.g."
+       << endl
+       << "              trace=a.trace.bz2:2,trace=b.trace:1,sched=wfq" << endl
+       << "  -M <spec>   miss-ratio curve and estimated latency of an LRU cache"
+       << endl
+       << "              in front of the HDD for the trace or the -g workload"
+       << endl
+       << "              (see mrc.h), e.g. block=4K,rate=0.01,min=1M,max=64G"
+       << endl
+       << "  -W <spec>   replay the trace or the -g workload on all "
+          "combinations" << endl
+       << "              of the given HDD parameters in one pass (see sweep.h),"
+       << endl
+       << "              e.g. rpm=5400:7200:10000,pertrack=0.00005:0.00002"
+       << endl
+       << "  -w <spec>   replay a time window of an indexed trace (see "
+          "traceindex.h" << endl
+       << "              and trace_ingest) after a warm-up, e.g."
+       << endl
+       << "              trace=big.trace.bz2,from=-60,warm=10" << endl
+       << "  -t <spec>   record the phases of each request in a Chrome "
+          "trace-event" << endl
+       << "              file (see tracing.h; needs make TRACE=1), e.g."
+       << endl
+       << "              out=trace.json,events=4M" << endl
+       << "  -S <spec>   run as a service on a Unix domain socket:" << endl
+       << "              <path>[,threads=<n>] (HDD parameters are not "
+          "read)" << endl
+       << "  -L <spec>   load-test a service with requests from -g:" << endl
+       << "              <path>[,clients=<n>,batches=<n>,batch=<n>]" << endl
+       << "  -C <spec>   write a snapshot every <n> requests: <n>:<path> (trace"
+       << endl
+       << "              replay and open-loop synthetic workloads)" << endl
+       << "  -R <path>   resume from a snapshot taken with -C" << endl
+       << "  -h          print this help" << endl
+       << endl;
+}
+
+int main(int argc, char *argv[])
 {
   uint32 surfaces, tracks_per_surface, sectors_innermost, sectors_outermost,
          rpm, bytes_per_sector;
@@ -14,10 +307,169 @@ int main(void)
   bool   verbose;
 
   HDD *hdd;
-  double t;
+  SimTime t;
   char rw;
   uint64 address, length;
 
+  bool synthetic = false;
+  WorkloadConfig wcfg;
+  workload_defaults(&wcfg);
+  vector<uint32> depths;
+  Scheduler sched = QUEUE_FIFO;
+  bool cache = false, zoned = false, managed = false;
+  PowerConfig pcfg;
+  power_defaults(&pcfg);
+  SMRConfig zcfg;
+  smr_defaults(&zcfg);
+  HybridConfig ccfg;
+  hybrid_defaults(&ccfg);
+  string service_path, load_path;
+  uint32 threads = 4;
+  SvcLoadConfig lcfg;
+  service_load_defaults(&lcfg);
+  uint64 ckpt_every = 0;
+  bool sampled = false, blocked = false, heat = false, relocate = false;
+  bool shared = false, linked = false, curve = false, traced = false;
+  bool swept = false, windowed = false;
+  BusConfig icfg;
+  bus_defaults(&icfg);
+  TenantConfig tcfg;
+  tenant_defaults(&tcfg);
+  WindowConfig vcfg;
+  window_defaults(&vcfg);
+  SweepConfig wscfg;
+  sweep_defaults(&wscfg);
+  TracingConfig rcfg;
+  tracing_defaults(&rcfg);
+  MrcConfig mcfg;
+  mrc_defaults(&mcfg);
+  RemapConfig ocfg;
+  remap_defaults(&ocfg);
+  HeatmapConfig hcfg;
+  heatmap_defaults(&hcfg);
+  BlockConfig bcfg;
+  block_defaults(&bcfg);
+  SampleConfig fcfg;
+  sample_defaults(&fcfg);
+  string ckpt_path, resume_path;
+
+  //
+  // parse command line
+  //
+  int opt;
+  const char *optstring = "g:q:s:c:z:P:S:L:C:R:F:B:H:O:T:I:M:W:w:t:h";
+  while ((opt = getopt(argc, argv, optstring)) != -1) {
+    switch (opt) {
+      case 'C':
+        if (!parse_checkpoint(optarg, &ckpt_every, &ckpt_path)) {
+          cout << "invalid checkpoint specification '" << optarg << "'" << endl;
+          return EXIT_FAILURE;
+        }
+        break;
+      case 'w':
+        if (!window_parse(optarg, &vcfg)) return EXIT_FAILURE;
+        windowed = true;
+        break;
+      case 'W':
+        if (!sweep_parse(optarg, &wscfg)) return EXIT_FAILURE;
+        swept = true;
+        break;
+      case 't':
+        if (!tracing_parse(optarg, &rcfg)) return EXIT_FAILURE;
+        traced = true;
+        break;
+      case 'M':
+        if (!mrc_parse(optarg, &mcfg)) return EXIT_FAILURE;
+        curve = true;
+        break;
+      case 'I':
+        if (!bus_parse(optarg, &icfg)) return EXIT_FAILURE;
+        linked = true;
+        break;
+      case 'T':
+        if (!tenant_parse(optarg, &tcfg)) return EXIT_FAILURE;
+        shared = true;
+        break;
+      case 'O':
+        if (!remap_parse(optarg, &ocfg)) return EXIT_FAILURE;
+        relocate = true;
+        break;
+      case 'H':
+        if (!heatmap_parse(optarg, &hcfg)) return EXIT_FAILURE;
+        heat = true;
+        break;
+      case 'B':
+        if (!block_parse(optarg, &bcfg)) return EXIT_FAILURE;
+        blocked = true;
+        break;
+      case 'F':
+        if (!sample_parse(optarg, &fcfg)) return EXIT_FAILURE;
+        sampled = true;
+        break;
+      case 'R':
+        resume_path = optarg;
+        break;
+      case 'P':
+        if (!power_parse(optarg, &pcfg)) return EXIT_FAILURE;
+        managed = true;
+        break;
+      case 'z':
+        if (!smr_parse(optarg, &zcfg)) return EXIT_FAILURE;
+        zoned = true;
+        break;
+      case 'c':
+        if (!hybrid_parse(optarg, &ccfg)) return EXIT_FAILURE;
+        cache = true;
+        break;
+      case 'S':
+        if (!service_parse(optarg, &service_path, &threads)) {
+          return EXIT_FAILURE;
+        }
+        break;
+      case 'L':
+        if (!service_load_parse(optarg, &load_path, &lcfg)) return EXIT_FAILURE;
+        break;
+      case 'g':
+        if (!workload_parse(optarg, &wcfg)) return EXIT_FAILURE;
+        synthetic = true;
+        break;
+      case 'q':
+        if (!parse_depths(optarg, &depths)) {
+          cout << "invalid I/O depths '" << optarg << "'" << endl;
+          return EXIT_FAILURE;
+        }
+        break;
+      case 's':
+        if      (strcmp(optarg, "fifo") == 0) sched = QUEUE_FIFO;
+        else if (strcmp(optarg, "sstf") == 0) sched = QUEUE_SSTF;
+        else {
+          cout << "invalid scheduler '" << optarg << "'" << endl;
+          return EXIT_FAILURE;
+        }
+        break;
+      default:
+        usage(argv[0]);
+        return opt == 'h' ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+  }
+
+  if (traced) {
+#ifndef DL_TRACE
+    cout << "tracing is not compiled in (make clean && make TRACE=1)" << endl;
+    return EXIT_FAILURE;
+#endif
+    if (!trace_open(rcfg)) return EXIT_FAILURE;
+  }
+
+  //
+  // service mode: devices are created by the clients
+  //
+  if (!service_path.empty()) {
+    bool ok = service_run(service_path.c_str(), threads);
+    ok = trace_close() && ok;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
   //
   // read HDD parameters
   //
@@ -38,6 +490,19 @@ int main(void)
   }
 
 
+  //
+  // load-test a running service
+  //
+  if (!load_path.empty()) {
+    dl_geometry geo = { surfaces, tracks_per_surface,
+                        sectors_innermost, sectors_outermost,
+                        rpm, bytes_per_sector,
+                        seek_overhead, seek_per_track };
+    return service_load(load_path.c_str(), geo, wcfg, lcfg) ? EXIT_SUCCESS
+                                                            : EXIT_FAILURE;
+  }
+
+
   //
   // create new instance of HDD
   //
@@ -47,35 +512,379 @@ int main(void)
       rpm, bytes_per_sector,
       seek_overhead, seek_per_track,
       verbose);
+  hdd->print_info(cout);
+  if (heat) hdd->set_heatmap(hcfg);
 
   //
   // standard tests
   //
   cout.precision(6);
   t = hdd->seek_time(0, tracks_per_surface/2);
-  cout << "avg. seek time:    " << dec << fixed << t << endl;
+  cout << "avg. seek time:    " << dec << fixed << sim_seconds(t) << endl;
 
   t = hdd->seek_time(0, 1);
-  cout << "seek 1 track:      " << dec << fixed << t << endl;
+  cout << "seek 1 track:      " << dec << fixed << sim_seconds(t) << endl;
 
   t = hdd->wait_time();
-  cout << "avg. rot. latency: " << dec << fixed << t << endl;
+  cout << "avg. rot. latency: " << dec << fixed << sim_seconds(t) << endl;
 
   t = hdd->read_time(1);
-  cout << "read 1 sector:     " << dec << fixed << t << endl;
+  cout << "read 1 sector:     " << dec << fixed << sim_seconds(t) << endl;
 
   t = hdd->write_time(1);
-  cout << "write 1 sector:    " << dec << fixed << t << endl;
+  cout << "write 1 sector:    " << dec << fixed << sim_seconds(t) << endl;
 
   cout << endl << endl;
 
 
+  //
+  // concurrent replay of the tenant traces, and of each trace alone
+  //
+  if (shared) {
+    TenantReplay tenants(hdd, tcfg);
+    if (!tenants.load()) {
+      delete hdd;
+      return EXIT_FAILURE;
+    }
+    tenants.run();
+
+    vector<double> alone;
+    for (size_t i=0; i<tenants.tenants(); i++) {
+      HDD solo(
+          surfaces, tracks_per_surface,
+          sectors_innermost, sectors_outermost,
+          rpm, bytes_per_sector,
+          seek_overhead, seek_per_track);
+      Replay replay(&solo);
+      tenants.trace(i)->rewind();
+      replay.run_open(tenants.trace(i));
+      alone.push_back(replay.response().mean());
+    }
+    tenants.report(cout, &alone);
+
+    return finish(hdd);
+  }
+
+
+  //
+  // replay of a time window of an indexed trace, after a warm-up
+  //
+  if (windowed) {
+    IndexedTrace trace(vcfg);
+    if (!trace.open()) {
+      delete hdd;
+      return EXIT_FAILURE;
+    }
+
+    // the requests before the window only bring the disk into its state
+    Replay replay(hdd);
+    Request req;
+    bool more;
+    while ((more = trace.next(&req)) && (req.ts < trace.window_start())) {
+      replay.submit(req, req.ts);
+    }
+    uint64 warmed = replay.requests();
+    replay.reset();
+    while (more) {
+      replay.submit(req, req.ts);
+      more = trace.next(&req);
+    }
+
+    trace.print_stats(cout);
+    cout << "warm-up: " << warmed << " requests" << endl;
+    replay.report(cout);
+
+    return finish(hdd);
+  }
+
+
+  //
+  // replay of the synthetic workload or the input file on many HDDs at once
+  //
+  if (swept) {
+    dl_geometry base = { surfaces, tracks_per_surface,
+                         sectors_innermost, sectors_outermost,
+                         rpm, bytes_per_sector,
+                         seek_overhead, seek_per_track };
+    vector<dl_geometry> geo;
+    if (!sweep_expand(wscfg, base, &geo)) {
+      delete hdd;
+      return EXIT_FAILURE;
+    }
+
+    Workload *src;
+    if (synthetic) src = new SyntheticWorkload(wcfg, hdd->capacity(),
+                                               bytes_per_sector);
+    else src = new TraceWorkload(cin);
+
+    HDDSweep sweep(geo, wscfg.threads);
+    sweep.run(src);
+    sweep.report(cout);
+
+    delete src;
+    return finish(hdd);
+  }
+
+
+  //
+  // miss-ratio curve of the synthetic workload or the input file in one pass
+  //
+  if (curve) {
+    Workload *src;
+    if (synthetic) src = new SyntheticWorkload(wcfg, hdd->capacity(),
+                                               bytes_per_sector);
+    else src = new TraceWorkload(cin);
+
+    MissRatioCurve mrc(mcfg);
+    Replay replay(hdd);
+    Request req;
+    SimTime busy = 0;
+    while (src->next(&req)) {
+      SimTime start = req.ts > busy ? req.ts : busy;
+      busy = replay.submit(req, req.ts);
+      mrc.access(req.address, req.size, sim_seconds(busy - start));
+    }
+    replay.report(cout);
+    mrc.print(cout);
+
+    delete src;
+    return finish(hdd);
+  }
+
+
+  //
+  // sampled replay of the synthetic workload or the input file
+  //
+  if (sampled) {
+    Workload *src;
+    if (synthetic) src = new SyntheticWorkload(wcfg, hdd->capacity(),
+                                               bytes_per_sector);
+    else src = new TraceWorkload(cin);
+    // a full replay for validation needs the stream twice
+    MemoryWorkload *trace = fcfg.full ? new MemoryWorkload(src) : NULL;
+
+    HDD *backing[2];
+    Disk *dev[2];
+    for (int i=0; i<(fcfg.full ? 2 : 1); i++) {
+      backing[i] = new HDD(
+          surfaces, tracks_per_surface,
+          sectors_innermost, sectors_outermost,
+          rpm, bytes_per_sector,
+          seek_overhead, seek_per_track);
+      dev[i] = backing[i];
+      if (cache) {
+        dev[i] = new HybridDisk(ccfg, backing[i], backing[i]->capacity());
+      }
+    }
+    if (heat) backing[0]->set_heatmap(hcfg);
+
+    SampledReplay sample(dev[0], fcfg);
+    double t0 = wall_time();
+    sample.run(trace ? trace : src);
+    double t1 = wall_time();
+
+    if (trace) {
+      Replay full(dev[1]);
+      trace->rewind();
+      full.run_open(trace);
+      double t2 = wall_time();
+
+      sample.report(cout, &full);
+      cout << "simulation time: sampled " << setprecision(6) << t1 - t0
+           << "s, full " << t2 - t1 << "s (" << setprecision(1)
+           << (t1 > t0 ? (t2 - t1) / (t1 - t0) : 0.0) << "x)" << endl << endl;
+    } else {
+      sample.report(cout);
+    }
+
+    for (int i=0; i<(fcfg.full ? 2 : 1); i++) {
+      if (cache) delete dev[i];
+      if (i > 0) delete backing[i];
+    }
+    delete trace;
+    delete src;
+    delete hdd;
+
+    // the sampled replay ran on backing[0]
+    return finish(backing[0]);
+  }
+
+
+  //
+  // replay synthetic workload
+  //
+  if (synthetic) {
+    SyntheticWorkload wl(wcfg, hdd->capacity(), bytes_per_sector);
+
+    if (!depths.empty()) {
+      sweep_depths(hdd, &wl, depths, sched);
+    } else {
+      Replay replay(hdd, sched);
+      if (wcfg.arrival == ARR_CLOSED) {
+        replay.run_closed(&wl, wcfg.iodepth);
+      } else {
+        if (!resume_path.empty()) {
+          Snapshot s;
+          if (!s.open(resume_path.c_str()) || !replay.restore(s, &wl) ||
+              !s.close()) {
+            cout << "cannot restore from snapshot '" << resume_path << "'"
+                 << endl;
+            delete hdd;
+            return EXIT_FAILURE;
+          }
+        }
+        if (ckpt_every > 0) {
+          replay.set_checkpoint(ckpt_every, ckpt_path.c_str());
+        }
+        if (!replay.run_open(&wl)) {
+          delete hdd;
+          return EXIT_FAILURE;
+        }
+      }
+      replay.report(cout);
+    }
+
+    return finish(hdd);
+  }
+
+
+  //
+  // replay of the input file with and without flash cache
+  //
+  if (cache) {
+    HDD *backing = new HDD(
+        surfaces, tracks_per_surface,
+        sectors_innermost, sectors_outermost,
+        rpm, bytes_per_sector,
+        seek_overhead, seek_per_track);
+    HybridDisk hybrid(ccfg, backing, backing->capacity());
+    TraceWorkload wl(cin);
+    compare(hdd, &hybrid, "HDD + flash cache", &wl);
+    hybrid.print_stats(cout);
+
+    delete backing;
+    return finish(hdd);
+  }
+
+
+  //
+  // replay of the input file on a conventional and a shingled HDD
+  //
+  if (zoned) {
+    SMRHDD smr(
+        surfaces, tracks_per_surface,
+        sectors_innermost, sectors_outermost,
+        rpm, bytes_per_sector,
+        seek_overhead, seek_per_track, zcfg);
+    TraceWorkload wl(cin);
+    compare(hdd, &smr, "SMR HDD", &wl);
+    smr.print_stats(cout);
+
+    return finish(hdd);
+  }
+
+
+  //
+  // replay of the input file with and without hot-data relocation
+  //
+  if (relocate) {
+    HDD backing(
+        surfaces, tracks_per_surface,
+        sectors_innermost, sectors_outermost,
+        rpm, bytes_per_sector,
+        seek_overhead, seek_per_track);
+    RemapDisk remap(ocfg, &backing, backing.capacity());
+    TraceWorkload wl(cin);
+    MemoryWorkload trace(&wl);
+    remap.optimise(&trace);
+    compare(hdd, &remap, "HDD with hot-data relocation", &trace);
+    remap.print_stats(cout);
+
+    return finish(hdd);
+  }
+
+
+  //
+  // replay of the input file with and without the host interface
+  //
+  if (linked) {
+    HDD linked_hdd(
+        surfaces, tracks_per_surface,
+        sectors_innermost, sectors_outermost,
+        rpm, bytes_per_sector,
+        seek_overhead, seek_per_track);
+    linked_hdd.set_bus(icfg);
+    TraceWorkload wl(cin);
+    compare(hdd, &linked_hdd, "HDD with host interface", &wl);
+    linked_hdd.bus()->print_stats(cout);
+
+    return finish(hdd);
+  }
+
+
+  //
+  // replay of the input file with idle power management
+  //
+  if (managed) {
+    HDD managed_hdd(
+        surfaces, tracks_per_surface,
+        sectors_innermost, sectors_outermost,
+        rpm, bytes_per_sector,
+        seek_overhead, seek_per_track);
+    managed_hdd.set_power(pcfg);
+    TraceWorkload wl(cin);
+    compare(hdd, &managed_hdd, "HDD with power management", &wl);
+    managed_hdd.power()->print_stats(cout);
+
+    return finish(hdd);
+  }
+
+
+  //
+  // replay of the input file with and without a block layer
+  //
+  if (blocked) {
+    HDD other(
+        surfaces, tracks_per_surface,
+        sectors_innermost, sectors_outermost,
+        rpm, bytes_per_sector,
+        seek_overhead, seek_per_track);
+    TraceWorkload wl(cin);
+    compare_block(hdd, &other, bcfg, &wl);
+
+    return finish(hdd);
+  }
+
+
+  //
+  // closed-loop replay of the input file at several I/O depths
+  //
+  if (!depths.empty()) {
+    TraceWorkload wl(cin);
+    sweep_depths(hdd, &wl, depths, sched);
+
+    return finish(hdd);
+  }
+
+
   //
   // process requests from input file
   //
-  cin >> t >> rw >> address >> length;
+  TraceWorkload trace(cin);
+  Request req;
+
+  if (!resume_path.empty() && !resume(resume_path.c_str(), hdd, &trace)) {
+    delete hdd;
+    return EXIT_FAILURE;
+  }
+
+  while (trace.next(&req)) {
+    TRACE_BEGIN(0, trace.count() - 1);
+    t = req.ts;
+    rw = req.rw;
+    address = req.address;
+    length = req.size;
 
-  while (cin.good()) {
     cout.precision(6);
     switch (rw) {
       case 'r': cout << "read"; break;
@@ -83,21 +892,26 @@ int main(void)
       default : cout << "error in input trace";
     }
 
-    cout << "(" << t << ", " << address << ", " << length << ") = ";
+    cout << "(";
+    print_time(cout, trace.origin(), t);
+    cout << ", " << address << ", " << length << ") = ";
     cout.flush();
 
     switch (rw) {
       case 'r': t = hdd->read(t, address, length); break;
       case 'w': t = hdd->write(t, address, length); break;
     }
-    cout.precision(6);
-    cout << t << endl;
+    TRACE_REQUEST(rw, req.ts, req.ts, t, address, length);
+    print_time(cout, trace.origin(), t);
+    cout << endl;
 
-    cin >> t >> rw >> address >> length;
+    if ((ckpt_every > 0) && (trace.count() % ckpt_every == 0) &&
+        !checkpoint(ckpt_path.c_str(), hdd, &trace)) {
+      delete hdd;
+      return EXIT_FAILURE;
+    }
   }
 
-  delete hdd;
-
-  return EXIT_SUCCESS;
+  return finish(hdd);
 }
 
@@ -39,6 +39,8 @@
 #include <iomanip>
 
 #include "hdd.h"
+#include "snapshot.h"
+#include "tracing.h"
 using namespace std;
 
 //------------------------------------------------------------------------------
@@ -49,9 +51,12 @@ HDD::HDD(uint32 surfaces, uint32 tracks_per_surface,
          uint32 rpm, uint32 sector_size,
          double seek_overhead, double seek_per_track,
          bool verbose)
-  : _surfaces(surfaces), _rpm(rpm), _sector_size(sector_size),
+  : _surfaces(surfaces), _verbose(verbose), _rpm(rpm),
+    _sector_size(sector_size),
     _seek_overhead(seek_overhead), _seek_per_track(seek_per_track),
-    _verbose(verbose)
+    _seek_base(sim_time(seek_overhead)),
+    _seek_track_ps((int64)(seek_per_track * 1e12 + 0.5)),
+    _half_turn(rpm > 0 ? (30 * SIM_SECOND + rpm / 2) / rpm : 0)
 {
   // TODO
 	inner = sectors_innermost_track;
@@ -64,100 +69,226 @@ HDD::HDD(uint32 surfaces, uint32 tracks_per_surface,
 		cout << "invalid rpm : rpm equals to zero" << endl;
 	}
 	tracks_per_sf = tracks_per_surface;
-	uint64 total_sectors = 0;
+	_power = NULL;
+	_heatmap = NULL;
+	_bus = NULL;
+	// cumulative sector table: decode() searches it instead of walking
+	// through the tracks
+	_track_sectors.resize(tracks_per_surface);
 	for(uint32 track=0; track<tracks_per_surface;track++){
-		total_sectors += num_of_sector(track) * _surfaces;
+		_track_sectors[track] = num_of_sector(track);
 	}
-  //
-  // print info
-  //
-  cout.precision(3);
-  double cap = (double)total_sectors * _sector_size / 1000000000.0;
-  cout << "HDD: " << endl
-       << "  surfaces:                  " << _surfaces << endl
-       << "  tracks/surface:            " << tracks_per_surface << endl
-       << "  sect on innermost track:   " << sectors_innermost_track << endl
-       << "  sect on outermost track:   " << sectors_outermost_track << endl
-       << "  rpm:                       " << rpm << endl
-       << "  sector size:               " << _sector_size << endl
-	   << "  number of sectors total:   " << total_sectors << endl
-	   << "  capacity (GB):             " << dec << fixed << cap << endl
-       << endl;
+	decode_init(&_table, _track_sectors, _surfaces, _sector_size,
+			&_track_start, &_track_bucket);
+	_total_sectors = _track_start[tracks_per_surface];
+
+	_kernel = decode_kernel(DECODE_SCALAR);
+	set_decode(DECODE_AUTO);
+	_pf_next = 0;
 }
 
 HDD::~HDD(void)
 {
   // TODO
+	delete _power;
+	delete _heatmap;
+	delete _bus;
 	if(_verbose)
 		cout << "HDD removed" << endl;
 }
 
+void HDD::print_info(ostream &os) const
+{
+  os.precision(3);
+  double cap = (double)_total_sectors * _sector_size / 1000000000.0;
+  os << "HDD: " << endl
+     << "  surfaces:                  " << _surfaces << endl
+     << "  tracks/surface:            " << tracks_per_sf << endl
+     << "  sect on innermost track:   " << inner << endl
+     << "  sect on outermost track:   " << outer << endl
+     << "  rpm:                       " << _rpm << endl
+     << "  sector size:               " << _sector_size << endl
+     << "  number of sectors total:   " << _total_sectors << endl
+     << "  capacity (GB):             " << dec << fixed << cap << endl
+     << endl;
+}
+
+void HDD::set_power(const PowerConfig &cfg)
+{
+  delete _power;
+  _power = new PowerManager(cfg);
+}
+
+void HDD::set_bus(const BusConfig &cfg)
+{
+  delete _bus;
+  _bus = new HostInterface(cfg, _sector_size, capacity());
+}
+
+void HDD::set_heatmap(const HeatmapConfig &cfg)
+{
+  delete _heatmap;
+  _heatmap = new Heatmap(cfg, tracks_per_sf);
+}
+
+void HDD::save(Snapshot &s) const
+{
+  // the geometry identifies the disk
+  s.begin("hdd");
+  s.put((uint64)_surfaces);
+  s.put((uint64)tracks_per_sf);
+  s.put((uint64)inner);
+  s.put((uint64)outer);
+  s.put((uint64)_rpm);
+  s.put((uint64)_sector_size);
+  s.put(_seek_overhead);
+  s.put(_seek_per_track);
+
+  s.put((uint64)_head_pos);
+  s.put((uint64)(_power != NULL));
+  if (_power) _power->save(s);
+  s.put((uint64)(_bus != NULL));
+  if (_bus) _bus->save(s);
+}
+
+bool HDD::restore(Snapshot &s)
+{
+  if (!s.expect("hdd")) return false;
+  if ((s.get_u64() != _surfaces) || (s.get_u64() != tracks_per_sf) ||
+      (s.get_u64() != inner) || (s.get_u64() != outer) ||
+      (s.get_u64() != _rpm) || (s.get_u64() != _sector_size) ||
+      (s.get_double() != _seek_overhead) ||
+      (s.get_double() != _seek_per_track)) {
+    cout << "snapshot of a different HDD geometry" << endl;
+    return false;
+  }
+
+  _head_pos = (uint32)s.get_u64();
+  bool power = s.get_u64() != 0;
+  if (power != (_power != NULL)) {
+    cout << "snapshot with different power management" << endl;
+    return false;
+  }
+  if ((_power != NULL) && !_power->restore(s)) return false;
+
+  bool bus = s.get_u64() != 0;
+  if (bus != (_bus != NULL)) {
+    cout << "snapshot with a different host interface" << endl;
+    return false;
+  }
+  return (_bus == NULL || _bus->restore(s)) && s.good();
+}
+
 uint64 min(uint64 a,uint64 b){
 	if(a<b)return a;
 	return b;
 }
 
-double HDD::read(double ts, uint64 address, uint64 size)
+SimTime HDD::read(SimTime ts, uint64 address, uint64 size)
 {
   // TODO
+	if(_bus){
+		ts = _bus->command(ts);
+		// served from the drive buffer without touching the media
+		if(_bus->hit(ts, address, size)){
+			SimTime end = _bus->transfer(ts, size);
+			TRACE_SPAN(TP_HIT, ts, end, _head_pos, size);
+			return end;
+		}
+	}
+	if(_power) ts = _power->wake_up(ts);
+	// drive may have to wake up first
 	HDD_Position pos;
+	uint64 first = address;
 	uint64 num_sector = (size+_sector_size-1)/_sector_size;
 	// how many sectors do we need to read
-	double delay_t = 0;
+	SimTime delay_t = 0;
 	// add ts at last because of error
 	while(num_sector > 0){
 		if(!decode(address, &pos)){
 			cout << "invalid parameter" << endl;
-			return ts + delay_t;
+			break;
 		}
+		SimTime start_t = delay_t;
+		uint32 from = _head_pos;
 		delay_t += seek_time(_head_pos, pos.track);
+		TRACE_SPAN(TP_SEEK, ts + start_t, ts + delay_t, pos.track, 0);
 		_head_pos = pos.track;
 		// _head_pos move to pos.track
 		delay_t += wait_time();
+		TRACE_SPAN(TP_ROTATE, ts + delay_t - wait_time(), ts + delay_t,
+				pos.track, 0);
+		SimTime data_t = delay_t;
 		uint64 access_sectors = min(num_sector, pos.max_access);
 		// read access_sectors at once
 		num_sector -= access_sectors;
 		delay_t += read_time(access_sectors);
+		TRACE_SPAN(TP_READ, ts + data_t, ts + delay_t, pos.track,
+				access_sectors * _sector_size);
+		if(_heatmap) _heatmap->access(sim_seconds(ts + start_t), from,
+				pos.track, access_sectors * _sector_size,
+				sim_seconds(delay_t - start_t));
+		// the data go to the host while the media delivers them
+		if(_bus) _bus->stream(ts + data_t, ts + delay_t,
+				access_sectors * _sector_size);
 
 		// get next address
 		address += (uint64)access_sectors * _sector_size;
 	}
+	if(_power) _power->busy(ts, ts + delay_t);
+	if(_bus) return _bus->read_done(ts, ts + delay_t, first, size);
 	return ts + delay_t;
 }
 
-double HDD::write(double ts, uint64 address, uint64 size)
+SimTime HDD::write(SimTime ts, uint64 address, uint64 size)
 {
   // TODO
+	if(_bus) ts = _bus->command(ts);
+	if(_power) ts = _power->wake_up(ts);
+	// drive may have to wake up first
 	HDD_Position pos;
+	uint64 first = address;
 	uint64 num_sector = (size+_sector_size-1)/_sector_size;
 	// how many sectors do we need to write
-	double delay_t = 0;
+	SimTime delay_t = 0;
 	// add ts at last because of error
 	while(num_sector > 0){
 		if(!decode(address, &pos)){
 			cout << "invalid parameter" << endl;
-			return ts + delay_t;
+			break;
 		}
+		SimTime start_t = delay_t;
+		uint32 from = _head_pos;
 		delay_t += seek_time(_head_pos, pos.track);
+		TRACE_SPAN(TP_SEEK, ts + start_t, ts + delay_t, pos.track, 0);
 		_head_pos = pos.track;
 		// _head_pos move to pos.track
 		delay_t += wait_time();
+		TRACE_SPAN(TP_ROTATE, ts + delay_t - wait_time(), ts + delay_t,
+				pos.track, 0);
 		uint64 access_sectors = min(num_sector, pos.max_access);
 		// write access_sectors at once
 		num_sector -= access_sectors;
 		delay_t += write_time(access_sectors);
+		TRACE_SPAN(TP_WRITE, ts + delay_t - write_time(access_sectors),
+				ts + delay_t, pos.track, access_sectors * _sector_size);
+		if(_heatmap) _heatmap->access(sim_seconds(ts + start_t), from,
+				pos.track, access_sectors * _sector_size,
+				sim_seconds(delay_t - start_t));
 
 		// get next address
 		address += (uint64)access_sectors * _sector_size;
 	}
+	if(_power) _power->busy(ts, ts + delay_t);
+	if(_bus) return _bus->write_done(ts, ts + delay_t, first, size);
 	return ts + delay_t;
 }
 
-double HDD::seek_time(uint32 from_track, uint32 to_track)
+SimTime HDD::seek_time(uint32 from_track, uint32 to_track)
 {
   // TODO
 	// if we don't need to move head
-	if(from_track == to_track) return 0.0;
+	if(from_track == to_track) return 0;
 
 	uint32 diff;
 	if(from_track < to_track){
@@ -166,62 +297,69 @@ double HDD::seek_time(uint32 from_track, uint32 to_track)
 	else{
 		diff = from_track - to_track;
 	}
-	// diff = track distance
-	return _seek_overhead + _seek_per_track * diff;
+	// diff = track distance (per-track time in ps)
+	return _seek_base + (diff * _seek_track_ps + 500) / 1000;
 }
 
-double HDD::wait_time(void)
+SimTime HDD::wait_time(void)
 {
   // TODO
 	//average wait_time
-	return 30.0 / _rpm;
+	return _half_turn;
 }
 
-double HDD::read_time(uint64 sectors)
+SimTime HDD::read_time(uint64 sectors)
 {
   // TODO
-	//get read time on this track
-	return 60.0 / _rpm * sectors / (num_of_sector(_head_pos));
+	//get read time on this track, rounded to the nanosecond
+	int64 turn = (int64)_rpm * num_of_sector(_head_pos);
+	return (60 * SIM_SECOND * sectors + turn / 2) / turn;
 }
 
-double HDD::write_time(uint64 sectors)
+SimTime HDD::write_time(uint64 sectors)
 {
   // TODO
-	//get write time on this track
-	return 60.0 / _rpm * sectors / num_of_sector(_head_pos);
+	//get write time on this track, rounded to the nanosecond
+	int64 turn = (int64)_rpm * num_of_sector(_head_pos);
+	return (60 * SIM_SECOND * sectors + turn / 2) / turn;
 }
 
 bool HDD::decode(uint64 address, HDD_Position *pos)
 {
   // TODO
-	address /= _sector_size;
-	// now, address = sector address
-
-	// address is sector-major
-	for(uint32 track = 0; track<tracks_per_sf;track++){
-
-		uint64 sectors = (uint64) _surfaces * num_of_sector(track);
-		// num of sectors in this track
-		if(address < sectors){ // position in this track
-			pos -> surface = address / num_of_sector(track);
-			// which surface?
-			pos -> track = track;
-			// surface, track determined
-			address %= num_of_sector(track);
-			pos -> sector = address;
-			// get sector index
-			pos -> max_access = (num_of_sector(track) - pos->sector) +
-					(_surfaces - pos->surface - 1) * num_of_sector(track);
-			// how many sectors until end of this track
-
-			return true;
-			// decode success
-		}
-		else{ // otherwise, go to next track
-			address -= sectors;
-		}
+	// address is sector-major: the cumulative sector table gives the
+	// track, the offset on the track the surface and sector
+	if((_pf_next < _pf_address.size()) && (_pf_address[_pf_next] == address)){
+		// invalid addresses were decoded as all zero
+		*pos = _pf_pos[_pf_next++];
+		return pos->max_access > 0;
 	}
-	return false;
+	return decode_address(&_table, address, pos);
+}
+
+bool HDD::set_decode(DecodeIsa isa)
+{
+  // the vector kernels need capacities below 2^52 bytes
+  if ((isa != DECODE_SCALAR) && (_table.capacity >= (1ULL << 52))) return false;
+
+  DecodeKernel kernel = decode_kernel(isa);
+  if (kernel == NULL) return false;
+  _kernel = kernel;
+  return true;
+}
+
+size_t HDD::decode_batch(const uint64 *address, size_t n,
+                         HDD_Position *pos) const
+{
+  return _kernel(&_table, address, n, pos);
+}
+
+void HDD::prefetch(const uint64 *address, size_t n)
+{
+  _pf_address.assign(address, address + n);
+  _pf_pos.resize(n);
+  decode_batch(address, n, _pf_pos.data());
+  _pf_next = 0;
 }
 
 
@@ -33,7 +33,14 @@
 #ifndef __CA_HDD_H__
 #define __CA_HDD_H__
 
+#include <iostream>
+#include <vector>
+
+#include "bus.h"
+#include "decode.h"
 #include "disk.h"
+#include "heatmap.h"
+#include "power.h"
 using namespace std;
 
 ///@brief struct encoding a byte position on the disk as a surface/track/sector 
@@ -77,14 +84,14 @@ class HDD : public Disk {
     /// @param address starting address (in bytes) of data to read
     /// @param size number of bytes to read
     /// @retval time when the access ends (ts + latency of access)
-    virtual double read(double ts, uint64 address, uint64 size);
+    virtual SimTime read(SimTime ts, uint64 address, uint64 size);
 
     /// @brief write @a size bytes to @a address
     /// @param ts timestamp of the event
     /// @param address starting address (in bytes) of data to write
     /// @param size number of bytes to write
     /// @retval time when the access ends (ts + latency of access)
-    virtual double write(double ts, uint64 address, uint64 size);
+    virtual SimTime write(SimTime ts, uint64 address, uint64 size);
 
     /// @}
 
@@ -93,16 +100,97 @@ class HDD : public Disk {
     /// @{
 
     /// @brief seek time to move the head from @from_track to @to_track
-    double seek_time(uint32 from_track, uint32 to_track);
+    SimTime seek_time(uint32 from_track, uint32 to_track);
 
     /// @brief average rotational latency
-    double wait_time(void);
+    SimTime wait_time(void);
 
     /// @brief time to read @sectors sectors
-    double read_time(uint64 sectors);
+    SimTime read_time(uint64 sectors);
 
     /// @brief time to write @sectors sectors
-    double write_time(uint64 sectors);
+    SimTime write_time(uint64 sectors);
+
+    /// @}
+
+
+    /// @name geometry
+    /// @{
+
+    /// @brief capacity of the disk in bytes
+    uint64 capacity(void) const { return _total_sectors * _sector_size; }
+
+    /// @brief number of bytes per sector
+    uint32 sector_size(void) const { return _sector_size; }
+
+    /// @brief print the geometry of the disk to @a os
+    void   print_info(ostream &os) const;
+
+    /// @brief translate the byte addresses @a address[0..n) into positions
+    ///        @a pos[0..n) with the fastest decode kernel of the CPU.
+    ///        Positions of invalid addresses are all zero.
+    /// @retval number of valid addresses
+    size_t decode_batch(const uint64 *address, size_t n,
+                        HDD_Position *pos) const;
+
+    /// @brief use the decode kernel for @a isa in decode_batch()
+    /// @retval true if the CPU supports @a isa, false otherwise
+    bool   set_decode(DecodeIsa isa);
+
+    /// @brief decode the addresses @a address[0..n) of the next requests with
+    ///        decode_batch(). read() and write() take the position of the
+    ///        first sector of these requests from there as long as they are
+    ///        served in this order.
+    void   prefetch(const uint64 *address, size_t n);
+
+    /// @}
+
+
+    /// @name power management
+    /// @{
+
+    /// @brief enable idle power states with configuration @a cfg
+    void   set_power(const PowerConfig &cfg);
+
+    /// @brief power manager (NULL if power management is disabled)
+    const PowerManager *power(void) const { return _power; }
+
+    /// @}
+
+
+    /// @name host interface
+    /// @{
+
+    /// @brief model the host link and the drive buffer with configuration
+    ///        @a cfg
+    void   set_bus(const BusConfig &cfg);
+
+    /// @brief host interface (NULL if the link is not modelled)
+    const HostInterface *bus(void) const { return _bus; }
+
+    /// @}
+
+
+    /// @name instrumentation
+    /// @{
+
+    /// @brief record where the accesses land with configuration @a cfg
+    void   set_heatmap(const HeatmapConfig &cfg);
+
+    /// @brief heatmap (NULL if not enabled)
+    const Heatmap *heatmap(void) const { return _heatmap; }
+
+    /// @}
+
+
+    /// @name snapshots
+    /// @{
+
+    /// @brief save the state of the disk to snapshot @a s
+    virtual void save(Snapshot &s) const;
+
+    /// @brief restore the state of the disk from snapshot @a s
+    virtual bool restore(Snapshot &s);
 
     /// @}
 
@@ -115,10 +203,25 @@ class HDD : public Disk {
     uint32 _sector_size;            ///< number of bytes per sector
     double _seek_overhead;          ///< seek overhead
     double _seek_per_track;         ///< seek time per track the head is moved
+    SimTime _seek_base;             ///< seek overhead (ns)
+    int64  _seek_track_ps;          ///< seek time per track (ps)
+    SimTime _half_turn;             ///< average rotational latency (ns)
     // TODO add more fields as necessary
 	uint32 inner;					///< sectors in innermost track
 	uint32 outer;					///< sectors in outermost track
 	uint32 tracks_per_sf;			///< tracks per surface
+	uint64 _total_sectors;			///< number of sectors on the disk
+	PowerManager *_power;			///< idle power states (or NULL)
+	Heatmap *_heatmap;				///< access heatmap (or NULL)
+	HostInterface *_bus;			///< host link and buffer (or NULL)
+	vector<uint64> _track_start;	///< first sector of each track (+ total)
+	vector<uint32> _track_sectors;	///< sectors per track and surface
+	vector<uint32> _track_bucket;	///< first track of each sector bucket
+	DecodeTable _table;				///< decode tables for the kernels
+	DecodeKernel _kernel;			///< batch decode kernel
+	vector<uint64> _pf_address;		///< prefetched addresses
+	vector<HDD_Position> _pf_pos;	///< their positions
+	size_t _pf_next;				///< next prefetched address
 
 
     /// @brief translate a byte address into a position on the HDD
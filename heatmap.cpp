@@ -0,0 +1,234 @@
+//------------------------------------------------------------------------------
+/// @brief spatial access heatmap and seek-distance profile
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include <algorithm>
+#include <functional>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+
+#include "heatmap.h"
+#include "options.h"
+using namespace std;
+
+//------------------------------------------------------------------------------
+// HeatmapConfig
+//
+void heatmap_defaults(HeatmapConfig *cfg)
+{
+  cfg->zones    = 100;
+  cfg->interval = 0.0;
+  cfg->prefix   = "";
+}
+
+static bool parse_option(const char *key, const char *val, void *ctx)
+{
+  HeatmapConfig *cfg = (HeatmapConfig*)ctx;
+  char c;
+
+  if (strcmp(key, "zones") == 0) {
+    return (sscanf(val, "%u%c", &cfg->zones, &c) == 1) && (cfg->zones > 0);
+  } else if (strcmp(key, "interval") == 0) {
+    return (sscanf(val, "%lf%c", &cfg->interval, &c) == 1) &&
+           (cfg->interval >= 0.0);
+  } else if (strcmp(key, "out") == 0) {
+    cfg->prefix = val;
+    return !cfg->prefix.empty();
+  }
+
+  return false;
+}
+
+bool heatmap_parse(const char *spec, HeatmapConfig *cfg)
+{
+  return parse_options(spec, parse_option, cfg, "heatmap");
+}
+
+
+//------------------------------------------------------------------------------
+// Heatmap
+//
+Heatmap::Heatmap(const HeatmapConfig &cfg, uint32 tracks)
+  : _cfg(cfg), _tracks(tracks > 0 ? tracks : 1),
+    _seek_tracks(0.0), _first(0.0), _started(false)
+{
+  if (_cfg.zones > _tracks) _cfg.zones = _tracks;
+  _accesses.assign(_cfg.zones, 0);
+  _bytes.assign(_cfg.zones, 0);
+  _time.assign(_cfg.zones, 0.0);
+  memset(_seeks, 0, sizeof(_seeks));
+}
+
+void Heatmap::access(double ts, uint32 from, uint32 to, uint64 bytes,
+                     double time)
+{
+  uint32 z = zone(to);
+  _accesses[z]++;
+  _bytes[z] += bytes;
+  _time[z] += time;
+
+  // bucket 0: no seek, bucket b: distance in [2^(b-1), 2^b)
+  uint32 d = from > to ? from - to : to - from;
+  _seeks[d == 0 ? 0 : 32 - __builtin_clz(d)]++;
+  _seek_tracks += d;
+
+  if (_cfg.interval > 0.0) {
+    if (!_started) _first = ts;
+    size_t row = ts > _first ? (size_t)((ts - _first) / _cfg.interval) : 0;
+    if ((row + 1) * _cfg.zones > _matrix.size()) {
+      _matrix.resize((row + 1) * _cfg.zones, 0);
+    }
+    _matrix[row * _cfg.zones + z] += bytes;
+  }
+  _started = true;
+}
+
+void Heatmap::print(ostream &os) const
+{
+  uint64 accesses = 0, bytes = 0, seeks = 0;
+  double time = 0.0;
+  for (uint32 z=0; z<_cfg.zones; z++) {
+    accesses += _accesses[z];
+    bytes += _bytes[z];
+    time += _time[z];
+  }
+  for (int b=1; b<HEATMAP_SEEK_BUCKETS; b++) seeks += _seeks[b];
+
+  // the busiest zones by time spent
+  vector<pair<double, uint32> > order(_cfg.zones);
+  for (uint32 z=0; z<_cfg.zones; z++) order[z] = make_pair(_time[z], z);
+  sort(order.begin(), order.end(), greater<pair<double, uint32> >());
+
+  os.precision(6);
+  os << "heatmap (" << _cfg.zones << " zones of " << _tracks << " tracks):"
+     << endl
+     << "  accesses:    " << accesses << " (" << seeks << " with a seek, mean "
+     << "distance " << dec << fixed << setprecision(1)
+     << (accesses > 0 ? _seek_tracks / accesses : 0.0) << " tracks)" << endl
+     << "  busiest zones:" << endl
+     << "     zone        tracks    accesses         bytes      time   share"
+     << endl;
+  for (uint32 i=0; (i<_cfg.zones) && (i<10) && (order[i].first > 0.0); i++) {
+    uint32 z = order[i].second;
+    os << "  " << setw(7) << z << setw(7) << first_track(z) << "-" << left
+       << setw(6) << last_track(z) << right << setw(12) << _accesses[z]
+       << setw(14) << _bytes[z] << setprecision(3) << setw(10) << _time[z]
+       << setprecision(1) << setw(7)
+       << (time > 0.0 ? 100.0 * _time[z] / time : 0.0) << "%" << endl;
+  }
+
+  os << "  seek distance (tracks):" << endl;
+  for (int b=0; b<HEATMAP_SEEK_BUCKETS; b++) {
+    if (_seeks[b] == 0) continue;
+    uint64 lo = b == 0 ? 0 : 1ULL << (b - 1), hi = b == 0 ? 0 : (1ULL << b) - 1;
+    os << "  " << setw(12) << lo << "-" << left << setw(12) << hi << right
+       << setw(12) << _seeks[b] << setprecision(1) << setw(7)
+       << (accesses > 0 ? 100.0 * _seeks[b] / accesses : 0.0) << "%" << endl;
+  }
+  os << endl;
+}
+
+bool Heatmap::write(void) const
+{
+  if (_cfg.prefix.empty()) return true;
+
+  string path;
+  bool ok = write_zones(path = _cfg.prefix + ".zones.csv") &&
+            write_seeks(path = _cfg.prefix + ".seeks.csv");
+  if (ok && (_cfg.interval > 0.0)) {
+    ok = write_matrix(path = _cfg.prefix + ".matrix.csv") &&
+         write_image(path = _cfg.prefix + ".pgm");
+  }
+
+  if (!ok) cout << "cannot write heatmap to '" << path << "'" << endl;
+  return ok;
+}
+
+bool Heatmap::write_zones(const string &path) const
+{
+  ofstream os(path.c_str());
+  os << "zone,first_track,last_track,accesses,bytes,time" << endl;
+  os.precision(9);
+  for (uint32 z=0; z<_cfg.zones; z++) {
+    os << z << "," << first_track(z) << "," << last_track(z) << ","
+       << _accesses[z] << "," << _bytes[z] << "," << fixed << _time[z] << endl;
+  }
+  return os.good();
+}
+
+bool Heatmap::write_seeks(const string &path) const
+{
+  ofstream os(path.c_str());
+  os << "min_distance,max_distance,count" << endl;
+  for (int b=0; b<HEATMAP_SEEK_BUCKETS; b++) {
+    uint64 lo = b == 0 ? 0 : 1ULL << (b - 1), hi = b == 0 ? 0 : (1ULL << b) - 1;
+    os << lo << "," << hi << "," << _seeks[b] << endl;
+  }
+  return os.good();
+}
+
+bool Heatmap::write_matrix(const string &path) const
+{
+  // one row per interval, one column per zone
+  ofstream os(path.c_str());
+  os << "time";
+  for (uint32 z=0; z<_cfg.zones; z++) os << ",z" << z;
+  os << endl;
+  os.precision(6);
+  for (size_t r=0; r<_matrix.size()/_cfg.zones; r++) {
+    os << fixed << _first + r * _cfg.interval;
+    for (uint32 z=0; z<_cfg.zones; z++) os << "," << _matrix[r*_cfg.zones + z];
+    os << endl;
+  }
+  return os.good();
+}
+
+bool Heatmap::write_image(const string &path) const
+{
+  // binary PGM: time runs down, zones from inner (left) to outer (right);
+  // the grey level is logarithmic in the bytes transferred
+  size_t rows = _matrix.size() / _cfg.zones;
+  uint64 peak = 0;
+  for (size_t i=0; i<_matrix.size(); i++) peak = max(peak, _matrix[i]);
+
+  ofstream img(path.c_str(), ios::binary);
+  img << "P5" << endl << _cfg.zones << " " << rows << endl << 255 << endl;
+  double scale = peak > 0 ? 255.0 / log1p((double)peak) : 0.0;
+  for (size_t i=0; i<_matrix.size(); i++) {
+    img.put((char)(uint8)(scale * log1p((double)_matrix[i]) + 0.5));
+  }
+  return img.good();
+}
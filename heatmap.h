@@ -0,0 +1,158 @@
+//------------------------------------------------------------------------------
+/// @brief spatial access heatmap and seek-distance profile
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_HEATMAP_H__
+#define __CA_HEATMAP_H__
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "disk.h"
+using namespace std;
+
+/// number of seek-distance buckets: distance 0, then one per power of two
+#define HEATMAP_SEEK_BUCKETS 33
+
+//------------------------------------------------------------------------------
+/// @brief configuration of the heatmap
+///
+/// A configuration is parsed from a comma-separated list of key=value pairs:
+///
+/// - zones=<n>                      number of zones (groups of adjacent
+///                                  tracks, zone 0 is innermost)
+/// - interval=<seconds>             time resolution of the zone/time matrix
+///                                  (0: no matrix)
+/// - out=<prefix>                   write <prefix>.zones.csv,
+///                                  <prefix>.seeks.csv, and, with a matrix,
+///                                  <prefix>.matrix.csv and <prefix>.pgm
+///
+typedef struct _heatmap_config {
+  uint32 zones;                     ///< number of zones
+  double interval;                  ///< length of a matrix row in seconds
+  string prefix;                    ///< prefix of the output files
+} HeatmapConfig;
+
+/// @brief initialize @a cfg with default values
+void heatmap_defaults(HeatmapConfig *cfg);
+
+/// @brief parse @a spec into @a cfg (on top of the values already in @a cfg)
+/// @retval true if @a spec was parsed successfully, false otherwise
+bool heatmap_parse(const char *spec, HeatmapConfig *cfg);
+
+
+//------------------------------------------------------------------------------
+/// @brief where on the platter the traffic lands
+///
+/// Heatmap accumulates, per zone of adjacent tracks, the number of track
+/// accesses, the bytes transferred, and the time spent (seek, rotation, and
+/// transfer) and records the distance of every head movement in a
+/// logarithmic histogram. All counters have a fixed size except the
+/// optional zone/time matrix, which grows by one row of bytes per zone and
+/// interval.
+///
+class Heatmap {
+  public:
+    /// @name constructor/destructor
+    /// @{
+
+    /// @brief constructor
+    /// @param cfg configuration
+    /// @param tracks number of tracks per surface
+    Heatmap(const HeatmapConfig &cfg, uint32 tracks);
+
+    /// @}
+
+
+    /// @name recording
+    /// @{
+
+    /// @brief the head moved from track @a from to track @a to at time @a ts
+    ///        and transferred @a bytes bytes there, taking @a time seconds
+    void   access(double ts, uint32 from, uint32 to, uint64 bytes, double time);
+
+    /// @}
+
+
+    /// @name output
+    /// @{
+
+    /// @brief print a summary (busiest zones, seek profile) to @a os
+    void   print(ostream &os) const;
+
+    /// @brief write the CSV files (and image) to the configured prefix
+    /// @retval true on success, false otherwise
+    bool   write(void) const;
+
+    /// @}
+
+
+  protected:
+    HeatmapConfig _cfg;             ///< configuration
+    uint32 _tracks;                 ///< tracks per surface
+    vector<uint64> _accesses;       ///< track accesses per zone
+    vector<uint64> _bytes;          ///< bytes transferred per zone
+    vector<double> _time;           ///< time spent per zone
+    uint64 _seeks[HEATMAP_SEEK_BUCKETS]; ///< seek-distance histogram
+    double _seek_tracks;            ///< sum of all seek distances
+    double _first;                  ///< time of the first access
+    bool   _started;                ///< true after the first access
+    vector<uint64> _matrix;         ///< bytes per interval (rows) and zone
+
+    /// @brief zone of track @a track
+    uint32 zone(uint32 track) const
+    {
+      return (uint32)((uint64)track * _cfg.zones / _tracks);
+    }
+
+    /// @brief first track of zone @a z
+    uint32 first_track(uint32 z) const
+    {
+      return (uint32)(((uint64)z * _tracks + _cfg.zones - 1) / _cfg.zones);
+    }
+
+    /// @brief last track of zone @a z
+    uint32 last_track(uint32 z) const
+    {
+      return z + 1 < _cfg.zones ? first_track(z + 1) - 1 : _tracks - 1;
+    }
+
+    /// @name output files
+    /// @{
+    bool   write_zones(const string &path) const;
+    bool   write_seeks(const string &path) const;
+    bool   write_matrix(const string &path) const;
+    bool   write_image(const string &path) const;
+    /// @}
+};
+
+#endif // __CA_HEATMAP_H__
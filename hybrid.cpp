@@ -0,0 +1,599 @@
+//------------------------------------------------------------------------------
+/// @brief hybrid storage: flash cache in front of a disk
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <iostream>
+#include <iomanip>
+
+#include "hybrid.h"
+#include "options.h"
+#include "snapshot.h"
+using namespace std;
+
+#define NIL  ((uint32)-1)           ///< end of list
+
+#define L_T1 0                      ///< recently used once (LRU: only list)
+#define L_T2 1                      ///< used at least twice (ARC)
+#define L_B1 2                      ///< ghosts evicted from T1 (ARC)
+#define L_B2 3                      ///< ghosts evicted from T2 (ARC)
+
+//------------------------------------------------------------------------------
+// HybridConfig
+//
+void hybrid_defaults(HybridConfig *cfg)
+{
+  cfg->cache_size      = 1ULL << 30;
+  cfg->block_size      = 4096;
+  cfg->admit           = ADMIT_ALL;
+  cfg->admit_max       = 65536;
+  cfg->evict           = EVICT_LRU;
+  cfg->write           = WRITE_THROUGH;
+  cfg->flash_read      = 0.00008;
+  cfg->flash_write     = 0.00002;
+  cfg->flash_bandwidth = 500e6;
+}
+
+static bool parse_option(const char *key, const char *val, void *ctx)
+{
+  HybridConfig *cfg = (HybridConfig*)ctx;
+
+  if (strcmp(key, "size") == 0) {
+    return parse_size(val, &cfg->cache_size) && cfg->cache_size > 0;
+  }
+  if (strcmp(key, "block") == 0) {
+    uint64 b;
+    if (!parse_size(val, &b) || (b == 0) || (b > 0xffffffffULL)) return false;
+    cfg->block_size = (uint32)b;
+    return true;
+  }
+  if (strcmp(key, "admit") == 0) {
+    if (strcmp(val, "all") == 0)    { cfg->admit = ADMIT_ALL; return true; }
+    if (strcmp(val, "second") == 0) { cfg->admit = ADMIT_SECOND; return true; }
+    if (strncmp(val, "size:", 5) == 0) {
+      cfg->admit = ADMIT_SIZE;
+      return parse_size(val+5, &cfg->admit_max);
+    }
+    return false;
+  }
+  if (strcmp(key, "evict") == 0) {
+    if (strcmp(val, "lru") == 0) { cfg->evict = EVICT_LRU; return true; }
+    if (strcmp(val, "arc") == 0) { cfg->evict = EVICT_ARC; return true; }
+    return false;
+  }
+  if (strcmp(key, "write") == 0) {
+    if (strcmp(val, "wt") == 0) { cfg->write = WRITE_THROUGH; return true; }
+    if (strcmp(val, "wb") == 0) { cfg->write = WRITE_BACK; return true; }
+    return false;
+  }
+  if (strcmp(key, "flash") == 0) {
+    double mbs;
+    if (sscanf(val, "%lf:%lf:%lf", &cfg->flash_read, &cfg->flash_write,
+               &mbs) != 3 || (mbs <= 0.0)) {
+      return false;
+    }
+    cfg->flash_bandwidth = mbs * 1e6;
+    return true;
+  }
+
+  return false;
+}
+
+bool hybrid_parse(const char *spec, HybridConfig *cfg)
+{
+  if (!parse_options(spec, parse_option, cfg, "cache")) return false;
+
+  if (cfg->cache_size < cfg->block_size) {
+    cout << "cache smaller than one block" << endl;
+    return false;
+  }
+  return true;
+}
+
+
+//------------------------------------------------------------------------------
+// HybridDisk
+//
+HybridDisk::HybridDisk(const HybridConfig &cfg, Disk *disk, uint64 capacity)
+  : _cfg(cfg), _disk(disk), _disk_capacity(capacity),
+    _disk_busy(0), _ssd_busy(0), _warming(false),
+    _blocks((uint32)(cfg.cache_size / cfg.block_size)),
+    _index(cfg.evict == EVICT_ARC ? 2 * (uint64)_blocks : _blocks),
+    _p(0.0),
+    _read_hits(0), _read_misses(0), _write_hits(0), _write_misses(0),
+    _admitted(0), _rejected(0), _evictions(0), _writebacks(0)
+{
+  _ssd = new SSD(cfg.flash_read, cfg.flash_write, cfg.flash_bandwidth);
+
+  // slots: cached blocks (+ ghosts for ARC)
+  uint32 slots = cfg.evict == EVICT_ARC ? 2 * _blocks : _blocks;
+  _blk.resize(slots);
+  _prev.resize(slots);
+  _next.resize(slots);
+  _list.resize(slots);
+  _dirty.resize(slots);
+  _free.reserve(slots);
+  for (uint32 s=slots; s>0; s--) _free.push_back(s-1);
+
+  for (int l=0; l<4; l++) {
+    _lru[l] = _mru[l] = NIL;
+    _len[l] = 0;
+  }
+
+  if (cfg.admit == ADMIT_SECOND) _seen.assign(_blocks, (uint64)-1);
+}
+
+HybridDisk::~HybridDisk(void)
+{
+  delete _ssd;
+}
+
+SimTime HybridDisk::disk_access(char rw, SimTime ts, uint64 address,
+                                uint64 size)
+{
+  if (address >= _disk_capacity) return ts;
+  if (address + size > _disk_capacity) size = _disk_capacity - address;
+
+  if (_warming) {
+    _disk->warm(ts, rw, address, size);
+    return ts;
+  }
+
+  SimTime start = ts > _disk_busy ? ts : _disk_busy;
+  _disk_busy = rw == 'w' ? _disk->write(start, address, size)
+                         : _disk->read(start, address, size);
+  return _disk_busy;
+}
+
+SimTime HybridDisk::ssd_access(char rw, SimTime ts, uint64 address,
+                               uint64 size)
+{
+  if (_warming) return ts;
+
+  SimTime start = ts > _ssd_busy ? ts : _ssd_busy;
+  _ssd_busy = rw == 'w' ? _ssd->write(start, address, size)
+                        : _ssd->read(start, address, size);
+  return _ssd_busy;
+}
+
+SimTime HybridDisk::read(SimTime ts, uint64 address, uint64 size)
+{
+  if (size == 0) return ts;
+
+  uint64 bs    = _cfg.block_size;
+  uint64 first = address / bs;
+  uint64 last  = (address + size - 1) / bs;
+  uint64 end   = address + size;
+  SimTime done = ts;
+
+  // split the request into runs of cached and missed blocks
+  uint64 run = first;
+  bool   run_hit = false;
+  for (uint64 b=first; b<=last+1; b++) {
+    uint32 slot;
+    bool is_hit = (b <= last) && cached(b, &slot);
+    if (is_hit) hit(slot);
+    if ((b > first) && ((b > last) || (is_hit != run_hit))) {
+      if (run_hit) {
+        // [run, b) from the cache
+        uint64 lo = run * bs > address ? run * bs : address;
+        uint64 hi = b * bs < end ? b * bs : end;
+        SimTime t = ssd_access('r', ts, lo, hi - lo);
+        if (t > done) done = t;
+        _read_hits += b - run;
+      } else {
+        // [run, b) from the disk, whole blocks; fill admitted blocks
+        SimTime t = disk_access('r', ts, run * bs, (b - run) * bs);
+        if (t > done) done = t;
+        _read_misses += b - run;
+        for (uint64 m=run; m<b; m++) {
+          if (admit(m, size)) {
+            insert(m, t);
+            ssd_access('w', t, m * bs, bs);
+          }
+        }
+      }
+      run = b;
+    }
+    run_hit = is_hit;
+  }
+
+  return done;
+}
+
+SimTime HybridDisk::write(SimTime ts, uint64 address, uint64 size)
+{
+  if (size == 0) return ts;
+
+  uint64 bs    = _cfg.block_size;
+  uint64 first = address / bs;
+  uint64 last  = (address + size - 1) / bs;
+  uint64 end   = address + size;
+  SimTime done = ts;
+
+  if (_cfg.write == WRITE_THROUGH) {
+    // the disk is always written; cached blocks are updated
+    done = disk_access('w', ts, address, size);
+    for (uint64 b=first; b<=last; b++) {
+      uint32 slot;
+      if (cached(b, &slot)) {
+        hit(slot);
+        _write_hits++;
+        SimTime t = ssd_access('w', ts, b * bs, bs);
+        if (t > done) done = t;
+      } else {
+        _write_misses++;
+      }
+    }
+    return done;
+  }
+
+  // write-back: cached and admitted blocks go to the cache, the rest to disk
+  uint64 run = first;
+  bool   run_cache = false;
+  for (uint64 b=first; b<=last+1; b++) {
+    bool to_cache = false;
+    if (b <= last) {
+      uint32 slot;
+      if (cached(b, &slot)) {
+        hit(slot);
+        _write_hits++;
+        to_cache = true;
+      } else {
+        _write_misses++;
+        to_cache = admit(b, size);
+        if (to_cache) slot = insert(b, ts);
+      }
+      if (to_cache) _dirty[slot] = 1;
+    }
+
+    if ((b > first) && ((b > last) || (to_cache != run_cache))) {
+      uint64 lo = run * bs > address ? run * bs : address;
+      uint64 hi = b * bs < end ? b * bs : end;
+      SimTime t = run_cache ? ssd_access('w', ts, lo, hi - lo)
+                            : disk_access('w', ts, lo, hi - lo);
+      if (t > done) done = t;
+      run = b;
+    }
+    run_cache = to_cache;
+  }
+
+  return done;
+}
+
+void HybridDisk::warm(SimTime ts, char rw, uint64 address, uint64 size)
+{
+  // run the cache logic with the devices switched off
+  _warming = true;
+  if (rw == 'w') write(ts, address, size);
+  else read(ts, address, size);
+  _warming = false;
+}
+
+bool HybridDisk::cached(uint64 blk, uint32 *slot) const
+{
+  return _index.find(blk, slot) && (_list[*slot] <= L_T2);
+}
+
+void HybridDisk::hit(uint32 slot)
+{
+  unlink(slot);
+  push_mru(_cfg.evict == EVICT_ARC ? L_T2 : L_T1, slot);
+}
+
+bool HybridDisk::admit(uint64 blk, uint64 size)
+{
+  bool ok;
+
+  switch (_cfg.admit) {
+    case ADMIT_SIZE:
+      ok = size <= _cfg.admit_max;
+      break;
+
+    case ADMIT_SECOND: {
+      // ARC ghosts have been seen before; otherwise check the filter
+      uint32 slot;
+      if (_index.find(blk, &slot)) {
+        ok = true;
+      } else {
+        uint64 h = (blk * 0x9e3779b97f4a7c15ULL >> 20) % _seen.size();
+        uint64 &seen = _seen[h];
+        ok = seen == blk;
+        seen = blk;
+      }
+      break;
+    }
+
+    default:
+      ok = true;
+  }
+
+  if (ok) _admitted++;
+  else _rejected++;
+  return ok;
+}
+
+uint32 HybridDisk::insert(uint64 blk, SimTime ts)
+{
+  uint32 slot;
+
+  if (_cfg.evict == EVICT_LRU) {
+    if (_len[L_T1] >= _blocks) evict(L_T1, -1, ts);
+    slot = alloc(blk);
+    push_mru(L_T1, slot);
+    return slot;
+  }
+
+  // ARC (Megiddo and Modha, FAST 2003)
+  double c = _blocks;
+  if (_index.find(blk, &slot)) {
+    // ghost hit: adapt the target size of T1 and refetch into T2
+    if (_list[slot] == L_B1) {
+      double delta = _len[L_B1] >= _len[L_B2] ? 1.0
+                                              : (double)_len[L_B2] / _len[L_B1];
+      _p = _p + delta < c ? _p + delta : c;
+      replace(false, ts);
+    } else {
+      double delta = _len[L_B2] >= _len[L_B1] ? 1.0
+                                              : (double)_len[L_B1] / _len[L_B2];
+      _p = _p - delta > 0.0 ? _p - delta : 0.0;
+      replace(true, ts);
+    }
+    unlink(slot);
+    _dirty[slot] = 0;
+    push_mru(L_T2, slot);
+    return slot;
+  }
+
+  uint32 l1 = _len[L_T1] + _len[L_B1];
+  uint32 total = l1 + _len[L_T2] + _len[L_B2];
+  if (l1 >= _blocks) {
+    if (_len[L_T1] < _blocks) {
+      drop(L_B1);
+      replace(false, ts);
+    } else {
+      evict(L_T1, -1, ts);
+    }
+  } else if (total >= _blocks) {
+    if (total >= 2 * _blocks) drop(L_B2);
+    replace(false, ts);
+  }
+
+  slot = alloc(blk);
+  push_mru(L_T1, slot);
+  return slot;
+}
+
+void HybridDisk::replace(bool in_b2, SimTime ts)
+{
+  uint32 t1 = _len[L_T1];
+  if ((t1 > 0) && ((t1 > _p) || (in_b2 && (t1 == (uint32)_p)) ||
+                   (_len[L_T2] == 0))) {
+    evict(L_T1, L_B1, ts);
+  } else if (_len[L_T2] > 0) {
+    evict(L_T2, L_B2, ts);
+  }
+}
+
+void HybridDisk::evict(uint32 from, int ghost, SimTime ts)
+{
+  uint32 slot = _lru[from];
+  if (slot == NIL) return;
+
+  uint64 bs = _cfg.block_size;
+  if (_dirty[slot]) {
+    // write back: read the block from flash, write it to the disk
+    SimTime t = ssd_access('r', ts, _blk[slot] * bs, bs);
+    disk_access('w', t, _blk[slot] * bs, bs);
+    _dirty[slot] = 0;
+    _writebacks++;
+  }
+  _evictions++;
+
+  unlink(slot);
+  if (ghost >= 0) push_mru(ghost, slot);
+  else release(slot);
+}
+
+void HybridDisk::drop(uint32 list)
+{
+  uint32 slot = _lru[list];
+  if (slot == NIL) return;
+
+  unlink(slot);
+  release(slot);
+}
+
+void HybridDisk::unlink(uint32 slot)
+{
+  uint32 l = _list[slot];
+  if (_prev[slot] != NIL) _next[_prev[slot]] = _next[slot];
+  else _lru[l] = _next[slot];
+  if (_next[slot] != NIL) _prev[_next[slot]] = _prev[slot];
+  else _mru[l] = _prev[slot];
+  _len[l]--;
+}
+
+void HybridDisk::push_mru(uint32 list, uint32 slot)
+{
+  _list[slot] = list;
+  _prev[slot] = _mru[list];
+  _next[slot] = NIL;
+  if (_mru[list] != NIL) _next[_mru[list]] = slot;
+  else _lru[list] = slot;
+  _mru[list] = slot;
+  _len[list]++;
+}
+
+uint32 HybridDisk::alloc(uint64 blk)
+{
+  uint32 slot = _free.back();
+  _free.pop_back();
+
+  _blk[slot] = blk;
+  _dirty[slot] = 0;
+  _index.insert(blk, slot);
+  return slot;
+}
+
+void HybridDisk::release(uint32 slot)
+{
+  _index.remove(_blk[slot]);
+  _free.push_back(slot);
+}
+
+void HybridDisk::save(Snapshot &s) const
+{
+  s.begin("hybrid");
+  s.put((uint64)_blocks);
+  s.put((uint64)_cfg.block_size);
+  s.put((uint64)_cfg.evict);
+  s.put((uint64)_cfg.admit);
+  s.put(_disk_busy);
+  s.put(_ssd_busy);
+
+  s.put(_blk);
+  s.put(_prev);
+  s.put(_next);
+  s.put(_list);
+  s.put(_dirty);
+  s.put(_free);
+  for (int l=0; l<4; l++) {
+    s.put((uint64)_lru[l]);
+    s.put((uint64)_mru[l]);
+    s.put((uint64)_len[l]);
+  }
+  s.put(_p);
+  s.put(_seen);
+
+  s.put(_read_hits);
+  s.put(_read_misses);
+  s.put(_write_hits);
+  s.put(_write_misses);
+  s.put(_admitted);
+  s.put(_rejected);
+  s.put(_evictions);
+  s.put(_writebacks);
+
+  _disk->save(s);
+}
+
+bool HybridDisk::restore(Snapshot &s)
+{
+  if (!s.expect("hybrid")) return false;
+  if ((s.get_u64() != _blocks) || (s.get_u64() != _cfg.block_size) ||
+      (s.get_u64() != (uint64)_cfg.evict) ||
+      (s.get_u64() != (uint64)_cfg.admit)) {
+    cout << "snapshot of a different cache configuration" << endl;
+    return false;
+  }
+  _disk_busy = s.get_i64();
+  _ssd_busy  = s.get_i64();
+
+  size_t slots = _blk.size();
+  size_t seen = _seen.size();
+  s.get(&_blk);
+  s.get(&_prev);
+  s.get(&_next);
+  s.get(&_list);
+  s.get(&_dirty);
+  s.get(&_free);
+  for (int l=0; l<4; l++) {
+    _lru[l] = (uint32)s.get_u64();
+    _mru[l] = (uint32)s.get_u64();
+    _len[l] = (uint32)s.get_u64();
+  }
+  _p = s.get_double();
+  s.get(&_seen);
+
+  _read_hits    = s.get_u64();
+  _read_misses  = s.get_u64();
+  _write_hits   = s.get_u64();
+  _write_misses = s.get_u64();
+  _admitted     = s.get_u64();
+  _rejected     = s.get_u64();
+  _evictions    = s.get_u64();
+  _writebacks   = s.get_u64();
+
+  if (!s.good() || (_blk.size() != slots) || (_prev.size() != slots) ||
+      (_next.size() != slots) || (_list.size() != slots) ||
+      (_dirty.size() != slots) || (_seen.size() != seen)) {
+    return false;
+  }
+
+  // rebuild the index from the lists
+  _index = BlockMap(slots);
+  for (int l=0; l<4; l++) {
+    for (uint32 slot=_lru[l]; slot!=NIL; slot=_next[slot]) {
+      if (slot >= slots) return false;
+      _index.insert(_blk[slot], slot);
+    }
+  }
+
+  return _disk->restore(s);
+}
+
+double HybridDisk::read_hit_ratio(void) const
+{
+  uint64 n = _read_hits + _read_misses;
+  return n > 0 ? (double)_read_hits / n : 0.0;
+}
+
+void HybridDisk::print_stats(ostream &os) const
+{
+  uint64 dirty = 0;
+  for (uint32 l=L_T1; l<=L_T2; l++) {
+    for (uint32 s=_lru[l]; s!=NIL; s=_next[s]) dirty += _dirty[s];
+  }
+  uint64 writes = _write_hits + _write_misses;
+
+  os.precision(4);
+  os << "hybrid cache: " << endl
+     << "  capacity:    " << _blocks << " blocks of " << _cfg.block_size
+     << " bytes" << endl
+     << "  policy:      admit="
+     << (_cfg.admit == ADMIT_ALL ? "all" :
+         _cfg.admit == ADMIT_SECOND ? "second" : "size")
+     << " evict=" << (_cfg.evict == EVICT_ARC ? "arc" : "lru")
+     << " write=" << (_cfg.write == WRITE_BACK ? "wb" : "wt") << endl
+     << "  read hits:   " << _read_hits << " / " << _read_hits + _read_misses
+     << " blocks (" << dec << fixed << 100.0 * read_hit_ratio() << "%)" << endl
+     << "  write hits:  " << _write_hits << " / " << writes << " blocks ("
+     << (writes > 0 ? 100.0 * _write_hits / writes : 0.0) << "%)" << endl
+     << "  admitted:    " << _admitted << " (rejected " << _rejected << ")"
+     << endl
+     << "  evictions:   " << _evictions << " (write-backs " << _writebacks
+     << ", dirty " << dirty << ")" << endl
+     << endl;
+}
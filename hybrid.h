@@ -0,0 +1,240 @@
+//------------------------------------------------------------------------------
+/// @brief hybrid storage: flash cache in front of a disk
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_HYBRID_H__
+#define __CA_HYBRID_H__
+
+#include <iostream>
+#include <vector>
+
+#include "disk.h"
+#include "ssd.h"
+#include "blockmap.h"
+using namespace std;
+
+/// @brief admission policies
+typedef enum {
+  ADMIT_ALL,                        ///< admit every missed block
+  ADMIT_SECOND,                     ///< admit blocks on their second miss
+  ADMIT_SIZE,                       ///< admit blocks of small requests only
+} Admission;
+
+/// @brief eviction policies
+typedef enum {
+  EVICT_LRU,                        ///< least recently used
+  EVICT_ARC,                        ///< adaptive replacement cache
+} Eviction;
+
+/// @brief write policies
+typedef enum {
+  WRITE_THROUGH,                    ///< writes go to the disk, cached blocks
+                                    ///< are updated (no write-allocate)
+  WRITE_BACK,                       ///< writes go to the cache, dirty blocks
+                                    ///< are written to the disk on eviction
+} WritePolicy;
+
+//------------------------------------------------------------------------------
+/// @brief configuration of a hybrid disk
+///
+/// A configuration is parsed from a comma-separated list of key=value pairs
+/// (sizes accept K, M, G suffixes):
+///
+/// - size=<bytes>                   cache capacity
+/// - block=<bytes>                  cache block size
+/// - admit=all|second|size:<bytes>  admission policy
+/// - evict=lru|arc                  eviction policy
+/// - write=wt|wb                    write policy
+/// - flash=<read>:<write>:<MB/s>    flash latencies (seconds) and bandwidth
+///
+typedef struct _hybrid_config {
+  uint64      cache_size;           ///< cache capacity in bytes
+  uint32      block_size;           ///< cache block size in bytes
+  Admission   admit;                ///< admission policy
+  uint64      admit_max;            ///< largest admitted request (ADMIT_SIZE)
+  Eviction    evict;                ///< eviction policy
+  WritePolicy write;                ///< write policy
+  double      flash_read;           ///< flash read latency
+  double      flash_write;          ///< flash write latency
+  double      flash_bandwidth;      ///< flash bandwidth in bytes/second
+} HybridConfig;
+
+/// @brief initialize @a cfg with default values
+void hybrid_defaults(HybridConfig *cfg);
+
+/// @brief parse @a spec into @a cfg (on top of the values already in @a cfg)
+/// @retval true if @a spec was parsed successfully, false otherwise
+bool hybrid_parse(const char *spec, HybridConfig *cfg);
+
+
+//------------------------------------------------------------------------------
+/// @brief hybrid storage: flash cache in front of a disk
+///
+/// HybridDisk composes an SSD used as a block cache in front of a (slow)
+/// backing disk. The cache works on blocks of HybridConfig::block_size
+/// bytes; missed blocks are fetched whole from the disk and, if admitted,
+/// filled into the cache in the background. The flash and the disk serve
+/// one access at a time each, so fills and write-backs delay later accesses
+/// to the same device.
+///
+/// Cached blocks are kept in slot arrays linked into LRU lists and located
+/// through a BlockMap, so all cache operations take O(1) time and about 40
+/// bytes per block. ARC additionally keeps up to one ghost entry per block.
+///
+class HybridDisk : public Disk {
+  public:
+    /// @name constructor/destructor
+    /// @{
+
+    /// @brief constructor
+    /// @param cfg cache configuration
+    /// @param disk backing disk
+    /// @param capacity capacity of the backing disk in bytes
+    HybridDisk(const HybridConfig &cfg, Disk *disk, uint64 capacity);
+
+    /// @brief destructor
+    virtual ~HybridDisk(void);
+
+    /// @}
+
+
+    /// @name access methods
+    /// @{
+
+    /// @brief read @a size bytes from @a address
+    virtual SimTime read(SimTime ts, uint64 address, uint64 size);
+
+    /// @brief write @a size bytes to @a address
+    virtual SimTime write(SimTime ts, uint64 address, uint64 size);
+
+    /// @brief update the cache for an access without timing it
+    virtual void warm(SimTime ts, char rw, uint64 address, uint64 size);
+
+    /// @}
+
+
+    /// @name statistics
+    /// @{
+
+    /// @brief print the cache statistics to @a os
+    void   print_stats(ostream &os) const;
+
+    /// @brief fraction of read blocks found in the cache
+    double read_hit_ratio(void) const;
+
+    /// @}
+
+
+    /// @name snapshots
+    /// @{
+
+    /// @brief save the state of the cache and the backing disk to @a s
+    virtual void save(Snapshot &s) const;
+
+    /// @brief restore the state of the cache and the backing disk from @a s
+    virtual bool restore(Snapshot &s);
+
+    /// @}
+
+
+  protected:
+    HybridConfig _cfg;              ///< configuration
+    Disk  *_disk;                   ///< backing disk
+    SSD   *_ssd;                    ///< cache device
+    uint64 _disk_capacity;          ///< capacity of the backing disk
+    SimTime _disk_busy;             ///< backing disk is busy until this time
+    SimTime _ssd_busy;              ///< cache device is busy until this time
+    bool   _warming;                ///< accesses update the state only
+
+    // cache state
+    uint32 _blocks;                 ///< capacity of the cache in blocks
+    BlockMap _index;                ///< block number -> slot
+    vector<uint64> _blk;            ///< block number of each slot
+    vector<uint32> _prev;           ///< previous slot in the list (to LRU)
+    vector<uint32> _next;           ///< next slot in the list (to MRU)
+    vector<uint8>  _list;           ///< list the slot is linked into
+    vector<uint8>  _dirty;          ///< slot holds modified data
+    vector<uint32> _free;           ///< unused slots
+    uint32 _lru[4];                 ///< LRU end of each list
+    uint32 _mru[4];                 ///< MRU end of each list
+    uint32 _len[4];                 ///< length of each list
+    double _p;                      ///< ARC: target size of T1
+    vector<uint64> _seen;           ///< ADMIT_SECOND: blocks missed once
+
+    // statistics
+    uint64 _read_hits;              ///< blocks read from the cache
+    uint64 _read_misses;            ///< blocks read from the disk
+    uint64 _write_hits;             ///< written blocks found in the cache
+    uint64 _write_misses;           ///< written blocks not in the cache
+    uint64 _admitted;               ///< blocks inserted into the cache
+    uint64 _rejected;               ///< blocks rejected by the admission
+    uint64 _evictions;              ///< blocks evicted from the cache
+    uint64 _writebacks;             ///< dirty blocks written to the disk
+
+    /// @brief access the backing disk, queueing behind earlier accesses
+    SimTime disk_access(char rw, SimTime ts, uint64 address, uint64 size);
+
+    /// @brief access the cache device, queueing behind earlier accesses
+    SimTime ssd_access(char rw, SimTime ts, uint64 address, uint64 size);
+
+    /// @brief true if block @a blk is cached; its slot is returned in @a slot
+    bool   cached(uint64 blk, uint32 *slot) const;
+
+    /// @brief update the replacement state on a hit of @a slot
+    void   hit(uint32 slot);
+
+    /// @brief admission decision for block @a blk of a request of @a size
+    bool   admit(uint64 blk, uint64 size);
+
+    /// @brief insert block @a blk into the cache at time @a ts
+    /// @retval slot of the block
+    uint32 insert(uint64 blk, SimTime ts);
+
+    /// @brief evict the LRU block of list @a from. With @a ghost the block is
+    ///        moved to the ghost list @a ghost, otherwise it is dropped.
+    void   evict(uint32 from, int ghost, SimTime ts);
+
+    /// @brief ARC replacement (REPLACE in Megiddo and Modha, FAST 2003)
+    void   replace(bool in_b2, SimTime ts);
+
+    /// @brief drop the LRU entry of ghost list @a list
+    void   drop(uint32 list);
+
+    /// @name list handling
+    /// @{
+    void   unlink(uint32 slot);
+    void   push_mru(uint32 list, uint32 slot);
+    uint32 alloc(uint64 blk);
+    void   release(uint32 slot);
+    /// @}
+};
+
+#endif // __CA_HYBRID_H__
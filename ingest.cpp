@@ -0,0 +1,175 @@
+//------------------------------------------------------------------------------
+/// @brief trace-ingest tool: block-compressed, time-indexed traces
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/stat.h>
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "traceindex.h"
+#include "compress.h"
+#include "workload.h"
+using namespace std;
+
+/// default number of requests per block
+#define INGEST_BLOCK 65536
+
+/// size of the file @a path in bytes (0 if it does not exist)
+static uint64 file_size(const string &path)
+{
+  struct stat st;
+  return stat(path.c_str(), &st) == 0 ? (uint64)st.st_size : 0;
+}
+
+/// append @a data to @a path as an independent bzip2 stream
+/// @retval true on success, false otherwise
+static bool append_block(const string &path, const string &data)
+{
+  string packed;
+  if (!bz2_compress(data, &packed)) return false;
+
+  ofstream os(path.c_str(), ios::binary | ios::app);
+  os.write(packed.data(), packed.size());
+  os.close();
+  return !os.fail();
+}
+
+/// append the requests @a data of block @a c to @a path and to @a index
+/// @retval true on success, false otherwise
+static bool flush_block(const string &path, const string &data, IndexChunk *c,
+                        TraceIndex *index)
+{
+  c->offset = file_size(path);
+  if (!append_block(path, data)) {
+    cout << "cannot compress to '" << path << "'" << endl;
+    return false;
+  }
+  c->length = file_size(path) - c->offset;
+  index->add(*c);
+  return true;
+}
+
+int main(int argc, char *argv[])
+{
+  if ((argc < 2) || (argc > 3)) {
+    cout << "Usage: " << argv[0] << " <out.bz2> [requests per block] < trace"
+         << endl
+         << endl
+         << "Writes the trace read from stdin to <out.bz2> as a sequence of"
+         << endl
+         << "independently compressed blocks, and their time index to"
+         << endl
+         << "<out.bz2>.idx (see traceindex.h)." << endl;
+    return EXIT_FAILURE;
+  }
+  string path = argv[1];
+  uint64 per_block = argc > 2 ? strtoull(argv[2], NULL, 10) : INGEST_BLOCK;
+  if (per_block == 0) {
+    cout << "invalid number of requests per block '" << argv[2] << "'" << endl;
+    return EXIT_FAILURE;
+  }
+
+  FILE *f = fopen(path.c_str(), "w");
+  if (f == NULL) {
+    cout << "cannot create '" << path << "'" << endl;
+    return EXIT_FAILURE;
+  }
+  fclose(f);
+
+  TraceIndex index;
+  IndexChunk c;
+  string line, block, ts;
+  uint64 requests = 0, bytes = 0;
+  bool header = true, first = true;
+  memset(&c, 0, sizeof(c));
+
+  while (getline(cin, line)) {
+    istringstream fields(line);
+    if (!(fields >> ts)) continue;
+    bytes += line.size() + 1;
+
+    // the geometry line (9 fields) is a stream of its own
+    if (header) {
+      string w;
+      int n = 1;
+      while (fields >> w) n++;
+      header = false;
+      if (n == 9) {
+        if (!append_block(path, line + "\n")) {
+          cout << "cannot compress to '" << path << "'" << endl;
+          return EXIT_FAILURE;
+        }
+        continue;
+      }
+    }
+
+    int64 sec;
+    SimTime ns;
+    if (!TraceWorkload::parse_timestamp(ts.c_str(), &sec, &ns)) {
+      cout << "invalid timestamp '" << ts << "' in line " << requests + 1
+           << endl;
+      return EXIT_FAILURE;
+    }
+    if (first) {
+      index.set_origin(sec);
+      first = false;
+    }
+    SimTime t = (sec - index.origin()) * SIM_SECOND + ns;
+    if ((c.records == 0) || (t < c.first)) c.first = t;
+    if ((c.records == 0) || (t > c.last)) c.last = t;
+    c.records++;
+    requests++;
+    block += line;
+    block += '\n';
+
+    if (c.records == per_block) {
+      if (!flush_block(path, block, &c, &index)) return EXIT_FAILURE;
+      block.clear();
+      c.records = 0;
+    }
+  }
+  if ((c.records > 0) && !flush_block(path, block, &c, &index)) {
+    return EXIT_FAILURE;
+  }
+
+  if (!index.save(path)) return EXIT_FAILURE;
+
+  cout << requests << " requests (" << bytes << " bytes) in "
+       << index.chunks() << " blocks, " << file_size(path)
+       << " bytes compressed" << endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,399 @@
+//------------------------------------------------------------------------------
+/// @brief one-pass miss-ratio curves
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <iostream>
+#include <iomanip>
+
+#include "mrc.h"
+#include "options.h"
+using namespace std;
+
+#define MRC_EMPTY ((uint64)-1)      ///< marker of unmarked times
+#define MRC_RUNS  4                 ///< runs kept per tracked block
+
+//------------------------------------------------------------------------------
+// MrcConfig
+//
+void mrc_defaults(MrcConfig *cfg)
+{
+  cfg->block_size = 4096;
+  cfg->rate       = 1.0;
+  cfg->track      = 256ULL << 10;
+  cfg->min_size   = 1ULL << 20;
+  cfg->max_size   = 64ULL << 30;
+  cfg->hit        = 0.0001;
+}
+
+static bool parse_option(const char *key, const char *val, void *ctx)
+{
+  MrcConfig *cfg = (MrcConfig*)ctx;
+
+  if (strcmp(key, "block") == 0) {
+    return parse_size(val, &cfg->block_size) && (cfg->block_size >= 512);
+  }
+  if (strcmp(key, "rate") == 0) {
+    char *end;
+    cfg->rate = strtod(val, &end);
+    return (*end == '\0') && (cfg->rate > 0.0) && (cfg->rate <= 1.0);
+  }
+  if (strcmp(key, "track") == 0) {
+    return parse_size(val, &cfg->track) && (cfg->track > 0) &&
+           (cfg->track <= (1ULL << 30));
+  }
+  if (strcmp(key, "min") == 0) {
+    return parse_size(val, &cfg->min_size) && (cfg->min_size > 0);
+  }
+  if (strcmp(key, "max") == 0) {
+    return parse_size(val, &cfg->max_size) && (cfg->max_size > 0);
+  }
+  if (strcmp(key, "hit") == 0) {
+    char *end;
+    cfg->hit = strtod(val, &end);
+    return (*end == '\0') && (cfg->hit >= 0.0);
+  }
+
+  return false;
+}
+
+bool mrc_parse(const char *spec, MrcConfig *cfg)
+{
+  if (!parse_options(spec, parse_option, cfg, "miss-ratio curve")) return false;
+
+  if (cfg->max_size < cfg->min_size) {
+    cout << "largest cache size smaller than the smallest" << endl;
+    return false;
+  }
+  return true;
+}
+
+
+//------------------------------------------------------------------------------
+// MissRatioCurve
+//
+MissRatioCurve::MissRatioCurve(const MrcConfig &cfg)
+  : _cfg(cfg), _last(cfg.track + 1), _now(0), _tracked(0), _clock(0),
+    _prune(MRC_RUNS * cfg.track), _nreq(0), _nref(0), _sampled(0),
+    _compactions(0)
+{
+  uint64 B = cfg.block_size;
+  for (uint64 s = cfg.min_size; s <= cfg.max_size; s *= 2) {
+    _sizes.push_back(s / B > 0 ? s / B : 1);
+  }
+
+  _threshold = (uint32)ceil(cfg.rate * MRC_HASH_RANGE);
+  if (_threshold == 0) _threshold = 1;
+
+  _tree.assign(2 * (cfg.track + 1) + 1, 0);
+  _owner.assign(2 * (cfg.track + 1), MRC_EMPTY);
+  _stamp.assign(2 * (cfg.track + 1), 0);
+
+  _blocks.assign(_sizes.size() + 1, 0.0);
+  _requests.assign(_sizes.size() + 1, 0.0);
+  _service.assign(_sizes.size() + 1, 0.0);
+}
+
+uint32 MissRatioCurve::hash(uint64 block)
+{
+  block ^= block >> 33;
+  block *= 0xc4ceb9fe1a85ec53ULL;
+  block ^= block >> 33;
+  block *= 0xff51afd7ed558ccdULL;
+  block ^= block >> 33;
+  return (uint32)(block >> 40);
+}
+
+void MissRatioCurve::update(uint32 t, int32 v)
+{
+  for (uint64 i = (uint64)t + 1; i < _tree.size(); i += i & -i) _tree[i] += v;
+}
+
+uint64 MissRatioCurve::prefix(uint32 t) const
+{
+  uint64 sum = 0;
+  for (uint64 i = (uint64)t + 1; i > 0; i -= i & -i) sum += _tree[i];
+  return sum;
+}
+
+int64 MissRatioCurve::reference(uint64 block)
+{
+  int64 d = -1;
+  uint32 t;
+
+  if (_last.find(block, &t)) {
+    d = prefix(_now - 1) - prefix(t);
+    update(t, -1);
+    _owner[t] = MRC_EMPTY;
+  } else {
+    _tracked++;
+    _heap.push(make_pair(hash(block), block));
+  }
+
+  if (_now == _owner.size()) compact();
+  update(_now, 1);
+  _owner[_now] = block;
+  _stamp[_now] = _clock++;
+  _last.insert(block, _now);
+  _now++;
+
+  return d;
+}
+
+uint64 MissRatioCurve::since(uint64 clock) const
+{
+  uint32 t = lower_bound(_stamp.begin(), _stamp.begin() + _now, clock) -
+             _stamp.begin();
+  if (t == _now) return 0;
+  return prefix(_now - 1) - (t > 0 ? prefix(t - 1) : 0);
+}
+
+void MissRatioCurve::record(uint64 first, uint64 end, const Runs &runs)
+{
+  // cut the runs overlapping [first, end) at its boundaries, the latest
+  // references of its unsampled blocks are in @a runs
+  Runs::iterator it = _runs.lower_bound(first);
+  if (it != _runs.begin()) {
+    Runs::iterator p = it;
+    p--;
+    if (p->second.first > first) {
+      if (p->second.first > end) {
+        _runs[end] = make_pair(p->second.first, p->second.second);
+      }
+      p->second.first = first;
+    }
+  }
+  while ((it != _runs.end()) && (it->first < end)) {
+    if (it->second.first > end) {
+      _runs[end] = make_pair(it->second.first, it->second.second);
+    }
+    _runs.erase(it++);
+  }
+
+  _runs.insert(runs.begin(), runs.end());
+
+  // blocks dropped from the sample while the request was served
+  for (size_t i=0; i<_dropped.size(); i++) {
+    uint64 b = _dropped[i].first;
+    Runs::iterator r = _runs.upper_bound(b);
+    if ((r != _runs.begin()) && ((--r)->second.first > b)) continue;
+    _runs[b] = make_pair(b + 1, _dropped[i].second);
+  }
+  _dropped.clear();
+
+  if (_runs.size() > _prune) prune();
+}
+
+void MissRatioCurve::prune(void)
+{
+  double scale = (double)MRC_HASH_RANGE / _threshold;
+  uint64 limit = MRC_RUNS * _cfg.track;
+  vector<uint64> clocks;
+
+  for (Runs::iterator it=_runs.begin(); it!=_runs.end(); ) {
+    if (since(it->second.second) * scale >= _sizes.back()) {
+      _runs.erase(it++);
+    } else {
+      clocks.push_back(it->second.second);
+      it++;
+    }
+  }
+
+  if (clocks.size() > limit) {
+    nth_element(clocks.begin(), clocks.end() - limit, clocks.end());
+    uint64 oldest = *(clocks.end() - limit);
+    for (Runs::iterator it=_runs.begin(); it!=_runs.end(); ) {
+      if (it->second.second < oldest) _runs.erase(it++);
+      else it++;
+    }
+  }
+  // prune again once the runs have doubled
+  _prune = 2 * _runs.size() > limit ? 2 * _runs.size() : limit;
+}
+
+void MissRatioCurve::shrink(void)
+{
+  while (_tracked > _cfg.track) {
+    _threshold = _heap.top().first;
+    while (!_heap.empty() && (_heap.top().first >= _threshold)) {
+      uint64 block = _heap.top().second;
+      uint32 t;
+      _heap.pop();
+      if (_last.find(block, &t)) {
+        // keep the latest reference, it becomes a run in record()
+        _dropped.push_back(make_pair(block, _stamp[t] + 1));
+        update(t, -1);
+        _owner[t] = MRC_EMPTY;
+        _last.remove(block);
+      }
+      _tracked--;
+    }
+  }
+}
+
+void MissRatioCurve::compact(void)
+{
+  uint32 n = 0;
+  for (uint32 t=0; t<_now; t++) {
+    if (_owner[t] == MRC_EMPTY) continue;
+    _owner[n] = _owner[t];
+    _stamp[n] = _stamp[t];
+    _last.insert(_owner[n], n);
+    n++;
+  }
+  for (uint32 t=n; t<_now; t++) _owner[t] = MRC_EMPTY;
+
+  // build the tree with all of 0..n-1 marked in O(size)
+  _tree.assign(_tree.size(), 0);
+  for (uint64 i=1; i<=n; i++) _tree[i] = 1;
+  for (uint64 i=1; i<_tree.size(); i++) {
+    uint64 j = i + (i & -i);
+    if (j < _tree.size()) _tree[j] += _tree[i];
+  }
+
+  _now = n;
+  _compactions++;
+}
+
+uint32 MissRatioCurve::bucket(double d) const
+{
+  uint32 i = 0;
+  while ((i < _sizes.size()) && (d >= _sizes[i])) i++;
+  return i;
+}
+
+void MissRatioCurve::access(uint64 address, uint64 size, double service)
+{
+  uint64 B = _cfg.block_size;
+  uint64 first = address / B;
+  uint64 last = (address + (size > 0 ? size : 1) - 1) / B;
+  uint32 worst = 0;
+  Runs runs;
+
+  _nreq++;
+  Runs::iterator it = _runs.upper_bound(first);
+  if (it != _runs.begin()) it--;
+  for (uint64 b=first; b<=last; b++) {
+    _nref++;
+    double scale = (double)MRC_HASH_RANGE / _threshold;
+
+    if (hash(b) >= _threshold) {
+      // latest reference from the run containing the block
+      while ((it != _runs.end()) && (it->second.first <= b)) it++;
+      uint32 i = _sizes.size();
+      if ((it != _runs.end()) && (it->first <= b)) {
+        i = bucket(since(it->second.second) * scale);
+      }
+      if (i > worst) worst = i;
+
+      // extend the run of this request or start a new one
+      if (!runs.empty() && (runs.rbegin()->second.first == b) &&
+          (runs.rbegin()->second.second == _clock)) {
+        runs.rbegin()->second.first = b + 1;
+      } else {
+        runs[b] = make_pair(b + 1, _clock);
+      }
+      continue;
+    }
+
+    int64 d = reference(b);
+    uint32 i = d < 0 ? _sizes.size() : bucket(d * scale);
+    _blocks[i] += scale;
+    if (i > worst) worst = i;
+    _sampled++;
+
+    if (_tracked > _cfg.track) shrink();
+  }
+  record(first, last + 1, runs);
+
+  _requests[worst] += 1.0;
+  _service[worst] += service;
+}
+
+/// print @a bytes with a K, M, or G suffix
+static void print_size(ostream &os, int width, uint64 bytes)
+{
+  const char *suffix = "";
+  if ((bytes >= (1ULL << 30)) && (bytes % (1ULL << 30) == 0)) {
+    bytes >>= 30; suffix = "G";
+  } else if ((bytes >= (1ULL << 20)) && (bytes % (1ULL << 20) == 0)) {
+    bytes >>= 20; suffix = "M";
+  } else if ((bytes >= (1ULL << 10)) && (bytes % (1ULL << 10) == 0)) {
+    bytes >>= 10; suffix = "K";
+  }
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%llu%s", bytes, suffix);
+  os << setw(width) << buf;
+}
+
+void MissRatioCurve::print(ostream &os) const
+{
+  uint32 n = _sizes.size();
+  double blocks = 0.0, requests = 0.0, service = 0.0;
+  for (uint32 i=0; i<=n; i++) {
+    blocks   += _blocks[i];
+    requests += _requests[i];
+    service  += _service[i];
+  }
+
+  os << "miss-ratio curve (LRU, " << _cfg.block_size << "-byte blocks): "
+     << endl
+     << "  references:  " << _nref << " blocks in " << _nreq << " requests, "
+     << _sampled << " sampled" << endl
+     << "  sampling:    rate " << dec << fixed << setprecision(6) << rate()
+     << ", " << _tracked << " blocks tracked, " << _compactions
+     << " renumberings" << endl
+     << "  uncached:    mean latency "
+     << (requests > 0.0 ? service / requests : 0.0) << endl
+     << "        cache  miss(blocks)  miss(requests)     latency" << endl;
+
+  // a reference in bucket i hits in caches of size _sizes[i] and larger
+  double hit_blocks = 0.0, hit_requests = 0.0, miss_service = service;
+  for (uint32 i=0; i<n; i++) {
+    hit_blocks   += _blocks[i];
+    hit_requests += _requests[i];
+    miss_service -= _service[i];
+
+    double mb = blocks > 0.0 ? 1.0 - hit_blocks / blocks : 0.0;
+    double mr = requests > 0.0 ? 1.0 - hit_requests / requests : 0.0;
+    double lat = requests > 0.0
+               ? (hit_requests * _cfg.hit + miss_service) / requests : 0.0;
+    os << "  ";
+    print_size(os, 11, _sizes[i] * _cfg.block_size);
+    os << setw(14) << mb << setw(16) << mr << setw(12) << lat << endl;
+  }
+  os << endl;
+}
@@ -0,0 +1,216 @@
+//------------------------------------------------------------------------------
+/// @brief one-pass miss-ratio curves
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_MRC_H__
+#define __CA_MRC_H__
+
+#include <iostream>
+#include <map>
+#include <queue>
+#include <vector>
+
+#include "disk.h"
+#include "blockmap.h"
+using namespace std;
+
+
+//------------------------------------------------------------------------------
+/// @brief configuration of the miss-ratio curve
+///
+/// A configuration is parsed from a comma-separated list of key=value pairs
+/// (sizes accept K, M, G suffixes):
+///
+/// - block=<bytes>                  cache block size (at least 512)
+/// - rate=<fraction>                initial spatial sampling rate
+/// - track=<blocks>                 maximal number of sampled blocks; the
+///                                  sampling rate is lowered to stay below
+/// - min=<bytes>                    smallest cache size of the curve
+/// - max=<bytes>                    largest cache size; the sizes in between
+///                                  are powers of two times min
+/// - hit=<seconds>                  latency of a cache hit
+///
+typedef struct _mrc_config {
+  uint64 block_size;                ///< cache block size in bytes
+  double rate;                      ///< initial sampling rate
+  uint64 track;                     ///< maximal number of sampled blocks
+  uint64 min_size;                  ///< smallest cache size in bytes
+  uint64 max_size;                  ///< largest cache size in bytes
+  double hit;                       ///< latency of a hit in seconds
+} MrcConfig;
+
+/// @brief initialize @a cfg with default values
+void mrc_defaults(MrcConfig *cfg);
+
+/// @brief parse @a spec into @a cfg (on top of the values already in @a cfg)
+/// @retval true if @a spec was parsed successfully, false otherwise
+bool mrc_parse(const char *spec, MrcConfig *cfg);
+
+
+//------------------------------------------------------------------------------
+/// @brief miss-ratio curve of an LRU cache computed in one pass
+///
+/// The reuse distance of a reference is the number of distinct blocks
+/// accessed since the previous reference to the same block; the reference
+/// hits in an LRU cache of C blocks iff its distance is smaller than C. The
+/// distances are computed with a Fenwick tree over the reference times, in
+/// which the time of the latest reference of each block is marked; the
+/// distance is then the number of marks after the previous reference, found
+/// in O(log n) time. When the tree is full, the marks are renumbered in
+/// place, so its size is bounded by the number of tracked blocks.
+///
+/// To bound the memory on large traces, only blocks whose hash falls below a
+/// threshold are tracked (spatial sampling as in SHARDS). The distances of
+/// the sampled blocks are scaled by the inverse of the sampling rate. Once
+/// more than MrcConfig::track blocks are tracked, the threshold is lowered to
+/// the largest hash in the sample, and the blocks at or above it are dropped.
+///
+/// For each cache size, the curve reports the miss ratio of the block
+/// references and of the requests (a request hits if all its blocks hit), and
+/// an estimate of the mean latency: the service time of the request on the
+/// uncached disk for misses, MrcConfig::hit for hits. The estimate ignores
+/// queueing and the effect of the cache on the head position.
+///
+/// With sampling, a request may hit in its sampled blocks and miss in the
+/// others. For the unsampled blocks, the time of the latest reference is kept
+/// per run of adjacent blocks referenced together, and their distance is the
+/// scaled number of sampled blocks referenced since. A block without a run is
+/// a first reference. Runs further away than the largest cache size are
+/// dropped, and so are the oldest ones beyond four runs per tracked block;
+/// their blocks then count as first references.
+///
+class MissRatioCurve {
+  public:
+    /// @name constructor/destructor
+    /// @{
+
+    /// @brief constructor
+    /// @param cfg configuration
+    MissRatioCurve(const MrcConfig &cfg);
+
+    /// @}
+
+
+    /// @name profiling
+    /// @{
+
+    /// @brief add a request of @a size bytes at @a address that takes
+    ///        @a service seconds on the uncached disk
+    void   access(uint64 address, uint64 size, double service);
+
+    /// @}
+
+
+    /// @name statistics
+    /// @{
+
+    /// @brief current sampling rate
+    double rate(void) const { return (double)_threshold / MRC_HASH_RANGE; }
+
+    /// @brief print the miss-ratio curve to @a os
+    void   print(ostream &os) const;
+
+    /// @}
+
+
+  protected:
+    /// range of the block hashes
+    static const uint32 MRC_HASH_RANGE = 1 << 24;
+
+    MrcConfig _cfg;                 ///< configuration
+    vector<uint64> _sizes;          ///< cache sizes in blocks
+    uint32 _threshold;              ///< blocks with a smaller hash are sampled
+
+    // reuse distances
+    BlockMap _last;                 ///< block -> time of its latest reference
+    vector<uint32> _tree;           ///< Fenwick tree of marked times
+    vector<uint64> _owner;          ///< block marked at each time (or empty)
+    uint32 _now;                    ///< next time
+    uint64 _tracked;                ///< sampled blocks
+    priority_queue<pair<uint32, uint64> > _heap; ///< sampled blocks by hash
+    vector<uint64> _stamp;          ///< sampled reference made at each time
+    uint64 _clock;                  ///< sampled references so far
+
+    // latest references of the unsampled blocks
+    typedef map<uint64, pair<uint64, uint64> > Runs;
+    Runs _runs;                     ///< first block -> (end, clock)
+    vector<pair<uint64, uint64> > _dropped; ///< unsampled blocks and clocks
+    size_t _prune;                  ///< number of runs that triggers pruning
+
+    // histograms indexed by the smallest cache size that hits, the last
+    // entry counts references that miss at all sizes
+    vector<double> _blocks;         ///< weighted block references
+    vector<double> _requests;       ///< weighted requests
+    vector<double> _service;        ///< weighted service time of requests
+
+    // statistics
+    uint64 _nreq;                   ///< requests
+    uint64 _nref;                   ///< block references
+    uint64 _sampled;                ///< sampled block references
+    uint64 _compactions;            ///< renumberings of the tree
+
+    /// @brief hash of @a block in [0, MRC_HASH_RANGE)
+    static uint32 hash(uint64 block);
+
+    /// @brief add @a v to the mark at time @a t
+    void   update(uint32 t, int32 v);
+
+    /// @brief number of marks at times up to and including @a t
+    uint64 prefix(uint32 t) const;
+
+    /// @brief reuse distance of a reference to @a block (in sampled blocks),
+    ///        or -1 on the first reference. Marks the block at the current
+    ///        time.
+    int64  reference(uint64 block);
+
+    /// @brief number of sampled blocks referenced since sampled reference
+    ///        @a clock
+    uint64 since(uint64 clock) const;
+
+    /// @brief replace the runs in [@a first, @a end) by @a runs and add the
+    ///        blocks dropped from the sample
+    void   record(uint64 first, uint64 end, const Runs &runs);
+
+    /// @brief drop the runs beyond the largest cache size and the oldest ones
+    ///        beyond MRC_RUNS per tracked block
+    void   prune(void);
+
+    /// @brief drop the sampled blocks with the largest hash
+    void   shrink(void);
+
+    /// @brief renumber the marked times to 0, 1, ...
+    void   compact(void);
+
+    /// @brief histogram index of the reuse distance @a d (in blocks)
+    uint32 bucket(double d) const;
+};
+
+#endif // __CA_MRC_H__
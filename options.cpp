@@ -0,0 +1,75 @@
+//------------------------------------------------------------------------------
+/// @brief parsing of option specifications
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <cstdlib>
+#include <cstring>
+
+#include <iostream>
+
+#include "options.h"
+using namespace std;
+
+bool parse_options(const char *spec, OptionHandler handler, void *ctx,
+                   const char *what)
+{
+  char *s = strdup(spec);
+  bool ok = true;
+
+  for (char *tok = strtok(s, ","); tok && ok; tok = strtok(NULL, ",")) {
+    char *eq = strchr(tok, '=');
+    if (eq == NULL) {
+      ok = false;
+    } else {
+      *eq = '\0';
+      ok = handler(tok, eq+1, ctx);
+    }
+    if (!ok) cout << "invalid " << what << " option '" << tok << "'" << endl;
+  }
+
+  free(s);
+  return ok;
+}
+
+bool parse_size(const char *val, uint64 *size)
+{
+  char *end;
+  uint64 v = strtoull(val, &end, 10);
+  if (end == val) return false;
+
+  switch (*end) {
+    case 'K': case 'k': v <<= 10; end++; break;
+    case 'M': case 'm': v <<= 20; end++; break;
+    case 'G': case 'g': v <<= 30; end++; break;
+  }
+  *size = v;
+  return *end == '\0';
+}
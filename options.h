@@ -0,0 +1,56 @@
+//------------------------------------------------------------------------------
+/// @brief parsing of option specifications
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_OPTIONS_H__
+#define __CA_OPTIONS_H__
+
+#include "disk.h"
+using namespace std;
+
+/// @brief handler of a single key=value option
+/// @retval true if the option is valid, false otherwise
+typedef bool (*OptionHandler)(const char *key, const char *val, void *ctx);
+
+/// @brief parse a comma-separated list of key=value pairs
+/// @param spec specification
+/// @param handler called for each option
+/// @param ctx passed to @a handler
+/// @param what name of the options (for error messages)
+/// @retval true if all options are valid, false otherwise
+bool parse_options(const char *spec, OptionHandler handler, void *ctx,
+                   const char *what);
+
+/// @brief parse a size in bytes with an optional K, M, or G suffix
+/// @retval true if @a val is a valid size, false otherwise
+bool parse_size(const char *val, uint64 *size);
+
+#endif // __CA_OPTIONS_H__
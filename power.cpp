@@ -0,0 +1,198 @@
+//------------------------------------------------------------------------------
+/// @brief idle-time power management of HDDs
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <cstdio>
+#include <cstring>
+
+#include <iostream>
+#include <iomanip>
+
+#include "power.h"
+#include "options.h"
+#include "snapshot.h"
+#include "tracing.h"
+using namespace std;
+
+static const char *state_name[PS_STATES] = {
+  "idle", "unload", "lowrpm", "standby"
+};
+
+//------------------------------------------------------------------------------
+// PowerConfig
+//
+void power_defaults(PowerConfig *cfg)
+{
+  cfg->timeout[PS_IDLE]     = 0.0;   cfg->wakeup[PS_IDLE]     = 0.0;
+  cfg->timeout[PS_UNLOADED] = 0.5;   cfg->wakeup[PS_UNLOADED] = 0.05;
+  cfg->timeout[PS_LOWRPM]   = 5.0;   cfg->wakeup[PS_LOWRPM]   = 1.0;
+  cfg->timeout[PS_STANDBY]  = 30.0;  cfg->wakeup[PS_STANDBY]  = 6.0;
+}
+
+static bool parse_option(const char *key, const char *val, void *ctx)
+{
+  PowerConfig *cfg = (PowerConfig*)ctx;
+
+  for (int s=PS_UNLOADED; s<PS_STATES; s++) {
+    if (strcmp(key, state_name[s]) == 0) {
+      if (strcmp(val, "off") == 0) {
+        cfg->timeout[s] = -1.0;
+        cfg->wakeup[s] = 0.0;
+        return true;
+      }
+      return sscanf(val, "%lf:%lf", &cfg->timeout[s], &cfg->wakeup[s]) == 2 &&
+             cfg->timeout[s] >= 0.0 && cfg->wakeup[s] >= 0.0;
+    }
+  }
+
+  return false;
+}
+
+bool power_parse(const char *spec, PowerConfig *cfg)
+{
+  if (!parse_options(spec, parse_option, cfg, "power")) return false;
+
+  double last = 0.0;
+  for (int s=PS_UNLOADED; s<PS_STATES; s++) {
+    if (cfg->timeout[s] < 0.0) continue;
+    if (cfg->timeout[s] < last) {
+      cout << "power state timeouts must increase with depth" << endl;
+      return false;
+    }
+    last = cfg->timeout[s];
+  }
+  return true;
+}
+
+
+//------------------------------------------------------------------------------
+// PowerManager
+//
+PowerManager::PowerManager(const PowerConfig &cfg)
+  : _cfg(cfg), _started(false), _last(0), _active(0), _waking(0)
+{
+  for (int s=0; s<PS_STATES; s++) {
+    _timeout[s] = cfg.timeout[s] < 0.0 ? -1 : sim_time(cfg.timeout[s]);
+    _wakeup[s] = sim_time(cfg.wakeup[s]);
+    _time[s] = 0;
+    _wakeups[s] = 0;
+  }
+}
+
+SimTime PowerManager::wake_up(SimTime ts)
+{
+  if (!_started || (ts <= _last)) {
+    _penalty.add(0.0);
+    return ts;
+  }
+
+  // walk through the states entered during the idle period
+  SimTime gap = ts - _last;
+  int     deepest = PS_IDLE;
+  SimTime entered = 0;
+  for (int s=PS_UNLOADED; s<PS_STATES; s++) {
+    if (_timeout[s] < 0) continue;
+    if (gap <= _timeout[s]) break;
+    _time[deepest] += _timeout[s] - entered;
+    entered = _timeout[s];
+    deepest = s;
+  }
+  _time[deepest] += gap - entered;
+
+  SimTime wake = _wakeup[deepest];
+  if (deepest != PS_IDLE) _wakeups[deepest]++;
+  _waking += wake;
+  _penalty.add(sim_seconds(wake));
+  if (wake > 0) TRACE_SPAN(TP_WAKE, ts, ts + wake, deepest, 0);
+
+  return ts + wake;
+}
+
+void PowerManager::busy(SimTime start, SimTime end)
+{
+  _started = true;
+  _active += end - start;
+  if (end > _last) _last = end;
+}
+
+void PowerManager::save(Snapshot &s) const
+{
+  s.begin("power");
+  s.put((uint64)_started);
+  s.put(_last);
+  s.put(_active);
+  s.put(_waking);
+  for (int i=0; i<PS_STATES; i++) {
+    s.put(_time[i]);
+    s.put(_wakeups[i]);
+  }
+  _penalty.save(s);
+}
+
+bool PowerManager::restore(Snapshot &s)
+{
+  if (!s.expect("power")) return false;
+  _started = s.get_u64() != 0;
+  _last    = s.get_i64();
+  _active  = s.get_i64();
+  _waking  = s.get_i64();
+  for (int i=0; i<PS_STATES; i++) {
+    _time[i]    = s.get_i64();
+    _wakeups[i] = s.get_u64();
+  }
+  return _penalty.restore(s);
+}
+
+void PowerManager::print_stats(ostream &os) const
+{
+  double total = sim_seconds(_active + _waking);
+  for (int s=0; s<PS_STATES; s++) total += sim_seconds(_time[s]);
+  if (total <= 0.0) total = 1.0;
+
+  os.precision(6);
+  os << "power states: " << endl
+     << "  active      " << dec << fixed << setw(16) << sim_seconds(_active)
+     << setprecision(2) << setw(8) << 100.0 * sim_seconds(_active) / total
+     << "%" << endl;
+  for (int s=0; s<PS_STATES; s++) {
+    os << "  " << left << setw(8) << state_name[s] << right
+       << setprecision(6) << setw(20) << sim_seconds(_time[s])
+       << setprecision(2) << setw(8) << 100.0 * sim_seconds(_time[s]) / total
+       << "%";
+    if (s != PS_IDLE) os << "  " << _wakeups[s] << " wake-ups";
+    os << endl;
+  }
+  os << "  waking      " << setprecision(6) << setw(16) << sim_seconds(_waking)
+     << setprecision(2) << setw(8) << 100.0 * sim_seconds(_waking) / total
+     << "%" << endl;
+  _penalty.print(os, "penalty");
+  os << endl;
+}
@@ -0,0 +1,138 @@
+//------------------------------------------------------------------------------
+/// @brief idle-time power management of HDDs
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_POWER_H__
+#define __CA_POWER_H__
+
+#include <iostream>
+
+#include "disk.h"
+#include "stats.h"
+using namespace std;
+
+/// @brief power states of an HDD (in order of increasing depth)
+typedef enum {
+  PS_IDLE,                          ///< spinning at full speed, not busy
+  PS_UNLOADED,                      ///< heads unloaded (parked)
+  PS_LOWRPM,                        ///< heads unloaded, spindle at reduced rpm
+  PS_STANDBY,                       ///< spindle stopped
+  PS_STATES                         ///< number of power states
+} PowerState;
+
+//------------------------------------------------------------------------------
+/// @brief configuration of the idle power states
+///
+/// A drive enters a state after it has been idle for the state's timeout;
+/// the next request then waits for the state's wake-up latency. A state with
+/// a negative timeout is disabled; timeouts must increase with the depth of
+/// the state. A configuration is parsed from a comma-separated list of
+/// key=value pairs:
+///
+/// - unload=<timeout>:<wakeup>|off
+/// - lowrpm=<timeout>:<wakeup>|off
+/// - standby=<timeout>:<wakeup>|off
+///
+typedef struct _power_config {
+  double timeout[PS_STATES];        ///< idle time before entering a state
+  double wakeup[PS_STATES];         ///< latency to return to full speed
+} PowerConfig;
+
+/// @brief initialize @a cfg with default values
+void power_defaults(PowerConfig *cfg);
+
+/// @brief parse @a spec into @a cfg (on top of the values already in @a cfg)
+/// @retval true if @a spec was parsed successfully, false otherwise
+bool power_parse(const char *spec, PowerConfig *cfg);
+
+
+//------------------------------------------------------------------------------
+/// @brief idle-time power management of an HDD
+///
+/// PowerManager tracks the idle periods between accesses of a drive,
+/// determines the power state the drive has reached when the next access
+/// arrives, and delays the access by the wake-up latency of that state. It
+/// records the time spent in each state and the latency penalty of the
+/// wake-ups.
+///
+class PowerManager {
+  public:
+    /// @name constructor/destructor
+    /// @{
+
+    /// @brief constructor
+    PowerManager(const PowerConfig &cfg);
+
+    /// @}
+
+
+    /// @name access methods
+    /// @{
+
+    /// @brief an access arrives at @a ts
+    /// @retval time when the drive is ready to serve the access
+    SimTime wake_up(SimTime ts);
+
+    /// @brief the drive is busy from @a start until @a end
+    void   busy(SimTime start, SimTime end);
+
+    /// @brief save the state to snapshot @a s
+    void   save(Snapshot &s) const;
+
+    /// @brief restore the state from snapshot @a s
+    bool   restore(Snapshot &s);
+
+    /// @}
+
+
+    /// @name statistics
+    /// @{
+
+    /// @brief print the power statistics to @a os
+    void   print_stats(ostream &os) const;
+
+    /// @}
+
+
+  protected:
+    PowerConfig _cfg;               ///< configuration
+    SimTime _timeout[PS_STATES];    ///< idle time before entering a state
+    SimTime _wakeup[PS_STATES];     ///< latency to return to full speed
+    bool   _started;                ///< true after the first access
+    SimTime _last;                  ///< end of the last access
+    SimTime _active;                ///< time spent serving accesses
+    SimTime _waking;                ///< time spent waking up
+    SimTime _time[PS_STATES];       ///< time spent in each state
+    uint64 _wakeups[PS_STATES];     ///< number of wake-ups from each state
+    LatencyStats _penalty;          ///< wake-up latency per access
+};
+
+#endif // __CA_POWER_H__
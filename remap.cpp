@@ -0,0 +1,240 @@
+//------------------------------------------------------------------------------
+/// @brief hot-data relocation
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <iomanip>
+
+#include "remap.h"
+#include "options.h"
+using namespace std;
+
+//------------------------------------------------------------------------------
+// RemapConfig
+//
+void remap_defaults(RemapConfig *cfg)
+{
+  cfg->extent_size = 1ULL << 20;
+  cfg->hot_size    = 1ULL << 30;
+  cfg->order       = ORDER_ADDRESS;
+  cfg->train       = 1.0;
+}
+
+static bool parse_option(const char *key, const char *val, void *ctx)
+{
+  RemapConfig *cfg = (RemapConfig*)ctx;
+
+  if (strcmp(key, "extent") == 0) {
+    return parse_size(val, &cfg->extent_size) && (cfg->extent_size >= 4096);
+  }
+  if (strcmp(key, "hot") == 0) {
+    return parse_size(val, &cfg->hot_size) && (cfg->hot_size > 0);
+  }
+  if (strcmp(key, "order") == 0) {
+    if (strcmp(val, "addr") == 0) { cfg->order = ORDER_ADDRESS; return true; }
+    if (strcmp(val, "heat") == 0) { cfg->order = ORDER_HEAT; return true; }
+    return false;
+  }
+  if (strcmp(key, "train") == 0) {
+    char *end;
+    cfg->train = strtod(val, &end);
+    return (*end == '\0') && (cfg->train > 0.0) && (cfg->train <= 1.0);
+  }
+
+  return false;
+}
+
+bool remap_parse(const char *spec, RemapConfig *cfg)
+{
+  if (!parse_options(spec, parse_option, cfg, "relocation")) return false;
+
+  if (cfg->hot_size < cfg->extent_size) {
+    cout << "hot band smaller than one extent" << endl;
+    return false;
+  }
+  return true;
+}
+
+
+//------------------------------------------------------------------------------
+// RemapDisk
+//
+RemapDisk::RemapDisk(const RemapConfig &cfg, Disk *disk, uint64 capacity)
+  : _cfg(cfg), _disk(disk), _extents(capacity / cfg.extent_size),
+    _index(2 * (cfg.hot_size / cfg.extent_size)),
+    _profiled(0), _touched(0), _hot(0), _moved(0), _coverage(0.0),
+    _requests(0), _pieces(0)
+{
+}
+
+void RemapDisk::optimise(MemoryWorkload *wl)
+{
+  uint64 E = _cfg.extent_size;
+
+  //
+  // profile: extents touched by the training requests, sorted so that the
+  // accesses to each extent form one run
+  //
+  vector<uint32> touched;
+  uint64 n = (uint64)(_cfg.train * wl->size() + 0.5);
+  if (n == 0) n = 1;
+
+  Request req;
+  wl->rewind();
+  while ((_profiled < n) && wl->next(&req)) {
+    _profiled++;
+    if ((req.size == 0) || (req.address >= _extents * E)) continue;
+    uint64 last = min((req.address + req.size - 1) / E, _extents - 1);
+    for (uint64 e=req.address / E; e<=last; e++) touched.push_back((uint32)e);
+  }
+  wl->rewind();
+  sort(touched.begin(), touched.end());
+
+  // (accesses, extent), hottest first
+  vector<pair<uint64, uint32> > heat;
+  for (size_t i=0; i<touched.size(); ) {
+    size_t j = i;
+    while ((j < touched.size()) && (touched[j] == touched[i])) j++;
+    heat.push_back(make_pair((uint64)(j - i), touched[i]));
+    i = j;
+  }
+  _touched = heat.size();
+  sort(heat.begin(), heat.end(), greater<pair<uint64, uint32> >());
+
+  //
+  // the K hottest extents move to the band of the K outermost extents. With
+  // ORDER_HEAT, the hottest extent goes to the outermost slot.
+  //
+  _hot = min(min(_cfg.hot_size / E, _extents), (uint64)heat.size());
+  if (_hot == 0) return;
+
+  uint64 covered = 0;
+  vector<uint32> hot(_hot);
+  for (uint64 i=0; i<_hot; i++) {
+    hot[i] = heat[i].second;
+    covered += heat[i].first;
+  }
+  _coverage = (double)covered / touched.size();
+
+  uint64 band = _extents - _hot;
+  vector<bool> is_hot(_hot, false);  // band slot i holds a hot extent
+  for (uint64 i=0; i<_hot; i++) {
+    if (hot[i] >= band) is_hot[hot[i] - band] = true;
+  }
+
+  vector<uint32> from;               // hot extents leaving their place
+  if (_cfg.order == ORDER_ADDRESS) sort(hot.begin(), hot.end());
+  for (uint64 i=0; i<_hot; i++) {
+    uint64 to = _cfg.order == ORDER_HEAT ? _extents - 1 - i : band + i;
+    if (hot[i] != to) _index.insert(hot[i], (uint32)to);
+    if (hot[i] < band) from.push_back(hot[i]);
+  }
+
+  // cold extents of the band take the places freed by the hot extents
+  sort(from.begin(), from.end());
+  size_t f = 0;
+  for (uint64 i=0; i<_hot; i++) {
+    if (is_hot[i]) continue;
+    _index.insert(band + i, from[f++]);
+  }
+  _moved = _index.size();
+}
+
+SimTime RemapDisk::access(char rw, SimTime ts, uint64 address, uint64 size)
+{
+  uint64 E = _cfg.extent_size;
+  _requests++;
+
+  // split at extent boundaries, translate, and merge contiguous pieces
+  SimTime t = ts;
+  uint64 start = 0, len = 0;
+  while (size > 0) {
+    uint64 off = address % E;
+    uint64 n = min(size, E - off);
+    uint64 to = translate(address / E) * E + off;
+
+    if ((len > 0) && (start + len == to)) {
+      len += n;
+    } else {
+      if (len > 0) {
+        t = rw == 'w' ? _disk->write(t, start, len)
+                      : _disk->read(t, start, len);
+        _pieces++;
+      }
+      start = to;
+      len = n;
+    }
+    address += n;
+    size -= n;
+  }
+  if (len > 0) {
+    t = rw == 'w' ? _disk->write(t, start, len) : _disk->read(t, start, len);
+    _pieces++;
+  }
+
+  return t;
+}
+
+SimTime RemapDisk::read(SimTime ts, uint64 address, uint64 size)
+{
+  return access('r', ts, address, size);
+}
+
+SimTime RemapDisk::write(SimTime ts, uint64 address, uint64 size)
+{
+  return access('w', ts, address, size);
+}
+
+void RemapDisk::print_stats(ostream &os) const
+{
+  uint64 E = _cfg.extent_size;
+
+  os.precision(2);
+  os << "hot-data relocation: " << endl
+     << "  extents:     " << _extents << " of " << E << " bytes, order="
+     << (_cfg.order == ORDER_HEAT ? "heat" : "addr") << endl
+     << "  profiled:    " << _profiled << " requests, " << _touched
+     << " distinct extents" << endl
+     << "  hot band:    " << _hot << " extents at " << dec << fixed
+     << (double)(_extents - _hot) * E / 1e9 << " GB, "
+     << 100.0 * _coverage << "% of the profiled accesses" << endl
+     << "  relocated:   " << _moved << " extents" << endl
+     << "  pieces:      " << _pieces << " disk accesses for " << _requests
+     << " requests" << endl
+     << endl;
+}
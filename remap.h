@@ -0,0 +1,163 @@
+//------------------------------------------------------------------------------
+/// @brief hot-data relocation
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_REMAP_H__
+#define __CA_REMAP_H__
+
+#include <iostream>
+#include <vector>
+
+#include "disk.h"
+#include "blockmap.h"
+#include "workload.h"
+using namespace std;
+
+/// @brief placement of the hot extents within the target band
+typedef enum {
+  ORDER_ADDRESS,                    ///< keep their order (sequential runs)
+  ORDER_HEAT,                       ///< hottest extents outermost
+} RemapOrder;
+
+//------------------------------------------------------------------------------
+/// @brief configuration of the hot-data relocation
+///
+/// A configuration is parsed from a comma-separated list of key=value pairs
+/// (sizes accept K, M, G suffixes):
+///
+/// - extent=<bytes>                 unit of relocation (at least 4K)
+/// - hot=<bytes>                    size of the band of hot extents at the
+///                                  outer edge of the disk
+/// - order=addr|heat                placement within the band
+/// - train=<fraction>               fraction of the trace that is profiled
+///
+typedef struct _remap_config {
+  uint64     extent_size;           ///< extent size in bytes
+  uint64     hot_size;              ///< size of the hot band in bytes
+  RemapOrder order;                 ///< placement within the band
+  double     train;                 ///< profiled fraction of the trace
+} RemapConfig;
+
+/// @brief initialize @a cfg with default values
+void remap_defaults(RemapConfig *cfg);
+
+/// @brief parse @a spec into @a cfg (on top of the values already in @a cfg)
+/// @retval true if @a spec was parsed successfully, false otherwise
+bool remap_parse(const char *spec, RemapConfig *cfg);
+
+
+//------------------------------------------------------------------------------
+/// @brief disk with hot extents relocated to the outer tracks
+///
+/// With zoned bit recording, the outer tracks (high addresses) hold more
+/// sectors than the inner ones and transfer data faster. RemapDisk profiles
+/// a trace, picks the most frequently accessed extents, and moves them into
+/// one band at the outer edge of the backing disk, where they are also close
+/// to each other. The extents displaced from the band take the places of the
+/// hot extents, so the mapping is a permutation of extents.
+///
+/// Relocated extents are kept in a BlockMap (extent -> extent), so a lookup
+/// takes O(1) time; extents not in the index are not moved. A request is
+/// split at extent boundaries, and pieces that remain contiguous after the
+/// translation are sent to the disk as one access.
+///
+class RemapDisk : public Disk {
+  public:
+    /// @name constructor/destructor
+    /// @{
+
+    /// @brief constructor
+    /// @param cfg relocation configuration
+    /// @param disk backing disk
+    /// @param capacity capacity of the backing disk in bytes
+    RemapDisk(const RemapConfig &cfg, Disk *disk, uint64 capacity);
+
+    /// @}
+
+
+    /// @name relocation
+    /// @{
+
+    /// @brief profile the first RemapConfig::train of the requests of @a wl
+    ///        and compute the relocation. Rewinds @a wl.
+    void   optimise(MemoryWorkload *wl);
+
+    /// @brief target extent of extent @a extent
+    inline uint64 translate(uint64 extent) const
+    {
+      uint32 to;
+      return _index.find(extent, &to) ? to : extent;
+    }
+
+    /// @}
+
+
+    /// @name access methods
+    /// @{
+
+    /// @brief read @a size bytes from @a address
+    virtual SimTime read(SimTime ts, uint64 address, uint64 size);
+
+    /// @brief write @a size bytes to @a address
+    virtual SimTime write(SimTime ts, uint64 address, uint64 size);
+
+    /// @}
+
+
+    /// @name statistics
+    /// @{
+
+    /// @brief print the relocation statistics to @a os
+    void   print_stats(ostream &os) const;
+
+    /// @}
+
+
+  protected:
+    RemapConfig _cfg;               ///< configuration
+    Disk  *_disk;                   ///< backing disk
+    uint64 _extents;                ///< number of whole extents of the disk
+    BlockMap _index;                ///< relocated extents
+
+    // statistics
+    uint64 _profiled;               ///< profiled requests
+    uint64 _touched;                ///< distinct extents in the profile
+    uint64 _hot;                    ///< extents in the hot band
+    uint64 _moved;                  ///< relocated extents (hot and displaced)
+    double _coverage;               ///< profiled accesses to hot extents
+    uint64 _requests;               ///< requests served
+    uint64 _pieces;                 ///< accesses sent to the backing disk
+
+    /// @brief serve a read (@a rw = 'r') or write (@a rw = 'w')
+    SimTime access(char rw, SimTime ts, uint64 address, uint64 size);
+};
+
+#endif // __CA_REMAP_H__
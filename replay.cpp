@@ -0,0 +1,224 @@
+//------------------------------------------------------------------------------
+/// @brief replay of request streams against a disk
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+#include "replay.h"
+#include "snapshot.h"
+#include "tracing.h"
+using namespace std;
+
+//------------------------------------------------------------------------------
+// Replay
+//
+Replay::Replay(Disk *disk, Scheduler sched)
+  : _disk(disk), _sched(sched), _next_address(0),
+    _busy_until(0), _first(0), _last(0),
+    _reads(0), _writes(0), _bytes(0), _ckpt_every(0),
+    _trace_device(TRACE_DEVICE())
+{
+}
+
+Replay::~Replay(void)
+{
+}
+
+SimTime Replay::submit(const Request &req, SimTime arrival)
+{
+  if (requests() == 0) _first = arrival;
+
+  SimTime start = arrival > _busy_until ? arrival : _busy_until;
+  SimTime end;
+
+  TRACE_BEGIN(_trace_device, requests());
+  if (req.rw == 'w') {
+    end = _disk->write(start, req.address, req.size);
+    _writes++;
+  } else {
+    end = _disk->read(start, req.address, req.size);
+    _reads++;
+  }
+  _bytes += req.size;
+  _next_address = req.address + req.size;
+  TRACE_REQUEST(req.rw, arrival, start, end, req.address, req.size);
+
+  _service.add(sim_seconds(end - start));
+  _response.add(sim_seconds(end - arrival));
+  _busy_until = end;
+  if (end > _last) _last = end;
+
+  return end;
+}
+
+SimTime Replay::skip(const Request &req, SimTime arrival, SimTime service)
+{
+  SimTime start = arrival > _busy_until ? arrival : _busy_until;
+
+  _disk->warm(start, req.rw, req.address, req.size);
+  _next_address = req.address + req.size;
+  _busy_until = start + service;
+  if (_busy_until > _last) _last = _busy_until;
+
+  return _busy_until;
+}
+
+bool Replay::run_open(Workload *wl)
+{
+  Request req;
+
+  while (wl->next(&req)) {
+    submit(req, req.ts);
+    if ((_ckpt_every > 0) && (requests() % _ckpt_every == 0) &&
+        !checkpoint(wl)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void Replay::run_closed(Workload *wl, uint32 iodepth)
+{
+  // outstanding requests and their issue times (in order of issue)
+  vector<Request> queue;
+  vector<SimTime> issued;
+  Request req;
+
+  // fill the queue
+  SimTime now = requests() > 0 ? _busy_until : 0;
+  while (queue.size() < iodepth && wl->next(&req)) {
+    queue.push_back(req);
+    issued.push_back(now);
+  }
+
+  while (!queue.empty()) {
+    // select the next request. All outstanding requests have been issued
+    // by the time the disk becomes idle.
+    size_t sel = 0;
+    if (_sched == QUEUE_SSTF) {
+      uint64 best = (uint64)-1;
+      for (size_t i=0; i<queue.size(); i++) {
+        uint64 a = queue[i].address;
+        uint64 d = a > _next_address ? a - _next_address : _next_address - a;
+        if (d < best) { best = d; sel = i; }
+      }
+    }
+
+    now = submit(queue[sel], issued[sel]);
+    queue.erase(queue.begin() + sel);
+    issued.erase(issued.begin() + sel);
+
+    // the completion issues the next request
+    if (wl->next(&req)) {
+      queue.push_back(req);
+      issued.push_back(now);
+    }
+  }
+}
+
+void Replay::reset(void)
+{
+  _first = _last = _busy_until;
+  _reads = _writes = _bytes = 0;
+  _service.reset();
+  _response.reset();
+}
+
+void Replay::set_checkpoint(uint64 every, const char *path)
+{
+  _ckpt_every = every;
+  _ckpt_path = path;
+}
+
+bool Replay::checkpoint(const Workload *wl) const
+{
+  Snapshot s;
+  if (!s.create(_ckpt_path.c_str())) return false;
+  save(s, wl);
+  return s.close();
+}
+
+void Replay::save(Snapshot &s, const Workload *wl) const
+{
+  s.begin("replay");
+  s.put(_next_address);
+  s.put(_busy_until);
+  s.put(_first);
+  s.put(_last);
+  s.put(_reads);
+  s.put(_writes);
+  s.put(_bytes);
+  _service.save(s);
+  _response.save(s);
+
+  _disk->save(s);
+  wl->save(s);
+}
+
+bool Replay::restore(Snapshot &s, Workload *wl)
+{
+  if (!s.expect("replay")) return false;
+  _next_address = s.get_u64();
+  _busy_until   = s.get_i64();
+  _first        = s.get_i64();
+  _last         = s.get_i64();
+  _reads        = s.get_u64();
+  _writes       = s.get_u64();
+  _bytes        = s.get_u64();
+
+  return _service.restore(s) && _response.restore(s) &&
+         _disk->restore(s) && wl->restore(s);
+}
+
+double Replay::iops(void) const
+{
+  return elapsed() > 0.0 ? requests() / elapsed() : 0.0;
+}
+
+void Replay::report(ostream &os) const
+{
+  os.precision(6);
+  os << "replay: " << endl
+     << "  requests:    " << requests()
+     << " (" << _reads << " reads, " << _writes << " writes)" << endl
+     << "  bytes:       " << _bytes << endl
+     << "  elapsed:     " << dec << fixed << elapsed() << endl
+     << "  iops:        " << iops() << endl
+     << "  MB/s:        " << (elapsed() > 0.0 ? _bytes / elapsed() / 1e6 : 0.0)
+     << endl
+     << "  utilization: "
+     << (elapsed() > 0.0 ? _service.sum() / elapsed() : 0.0) << endl;
+  _service.print(os, "service");
+  _response.print(os, "response");
+  os << endl;
+}
@@ -0,0 +1,153 @@
+//------------------------------------------------------------------------------
+/// @brief replay of request streams against a disk
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_REPLAY_H__
+#define __CA_REPLAY_H__
+
+#include <iostream>
+#include <string>
+
+#include "disk.h"
+#include "stats.h"
+#include "workload.h"
+using namespace std;
+
+/// @brief order in which outstanding requests are served
+typedef enum {
+  QUEUE_FIFO,                       ///< first come, first served
+  QUEUE_SSTF,                       ///< shortest (address) distance first
+} Scheduler;
+
+//------------------------------------------------------------------------------
+/// @brief replay of request streams against a disk
+///
+/// Replay feeds the requests of a Workload to a Disk. The disk serves one
+/// request at a time: a request that arrives while the disk is busy waits
+/// until the previous request has completed. With several requests
+/// outstanding (closed-loop replay), the scheduler selects the next one, like
+/// the command queue of a drive would. Replay records the service time (disk
+/// access only) and the response time (queueing + service) of every request.
+///
+class Replay {
+  public:
+    /// @name constructor/destructor
+    /// @{
+
+    /// @brief constructor
+    /// @param disk disk to serve the requests
+    /// @param sched scheduler for outstanding requests
+    Replay(Disk *disk, Scheduler sched=QUEUE_FIFO);
+
+    /// @brief destructor
+    virtual ~Replay(void);
+
+    /// @}
+
+
+    /// @name replay
+    /// @{
+
+    /// @brief serve request @a req arriving at time @a arrival
+    /// @retval time when the request completes
+    SimTime submit(const Request &req, SimTime arrival);
+
+    /// @brief open-loop replay: requests are issued at their timestamps
+    /// @retval false if a snapshot could not be written (the replay stops)
+    bool   run_open(Workload *wl);
+
+    /// @brief closed-loop replay: @a iodepth requests are kept outstanding,
+    ///        the completion of a request issues the next one. The
+    ///        timestamps of the requests are ignored.
+    void   run_closed(Workload *wl, uint32 iodepth);
+
+    /// @brief account for request @a req arriving at time @a arrival without
+    ///        simulating it (fast-forward): the disk state is warmed and the
+    ///        disk is assumed busy for @a service seconds. No statistics are
+    ///        recorded.
+    /// @retval estimated time when the request completes
+    SimTime skip(const Request &req, SimTime arrival, SimTime service);
+
+    /// @brief clear the statistics. The state of the queue is kept.
+    void   reset(void);
+
+    /// @brief write a snapshot to @a path every @a every requests of
+    ///        run_open(). The snapshot includes the disk and the workload.
+    void   set_checkpoint(uint64 every, const char *path);
+
+    /// @brief save the state of the replay, the disk, and @a wl to @a s
+    void   save(Snapshot &s, const Workload *wl) const;
+
+    /// @brief restore the state of the replay, the disk, and @a wl from @a s
+    bool   restore(Snapshot &s, Workload *wl);
+
+    /// @}
+
+
+    /// @name results
+    /// @{
+
+    /// @brief print a summary of the replay to @a os
+    void   report(ostream &os) const;
+
+    uint64 requests(void) const { return _reads + _writes; } ///< # requests
+    uint64 reads(void) const { return _reads; }              ///< # reads
+    uint64 writes(void) const { return _writes; }            ///< # writes
+    uint64 bytes(void) const { return _bytes; }              ///< # bytes
+    double elapsed(void) const { return sim_seconds(_last - _first); } ///< s
+    double iops(void) const;                                 ///< requests/s
+    const LatencyStats &service(void) const { return _service; }   ///< service
+    const LatencyStats &response(void) const { return _response; } ///< response
+
+    /// @}
+
+
+  protected:
+    Disk  *_disk;                   ///< disk serving the requests
+    Scheduler _sched;               ///< scheduler for outstanding requests
+    uint64 _next_address;           ///< address following the last request
+    SimTime _busy_until;            ///< time when the disk becomes idle
+    SimTime _first;                 ///< arrival time of the first request
+    SimTime _last;                  ///< completion time of the last request
+    uint64 _reads;                  ///< number of reads
+    uint64 _writes;                 ///< number of writes
+    uint64 _bytes;                  ///< number of bytes transferred
+    LatencyStats _service;          ///< service times
+    LatencyStats _response;         ///< response times
+    uint64 _ckpt_every;             ///< requests between snapshots (0: off)
+    string _ckpt_path;              ///< path of the snapshots
+    uint32 _trace_device;           ///< device in the trace (see tracing.h)
+
+    /// @brief write a snapshot of the replay of @a wl
+    bool   checkpoint(const Workload *wl) const;
+};
+
+#endif // __CA_REPLAY_H__
@@ -0,0 +1,252 @@
+//------------------------------------------------------------------------------
+/// @brief sampled (fast-forward) replay
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#include <iostream>
+#include <iomanip>
+
+#include "sample.h"
+#include "options.h"
+using namespace std;
+
+static const char *metric_name[SM_METRICS] = {
+  "service mean", "response mean", "response p50", "response p90",
+  "response p99"
+};
+
+/// two-sided 95% quantiles of Student's t distribution for 1..30 degrees of
+/// freedom
+static const double t95[30] = {
+  12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+  2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+  2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+};
+
+//------------------------------------------------------------------------------
+// SampleConfig
+//
+void sample_defaults(SampleConfig *cfg)
+{
+  cfg->period = 1000;
+  cfg->window = 100;
+  cfg->warmup = 20;
+  cfg->full   = false;
+}
+
+static bool parse_option(const char *key, const char *val, void *ctx)
+{
+  SampleConfig *cfg = (SampleConfig*)ctx;
+  char *end;
+
+  if (strcmp(key, "full") == 0) {
+    cfg->full = strcmp(val, "1") == 0;
+    return cfg->full || (strcmp(val, "0") == 0);
+  }
+
+  uint64 v = strtoull(val, &end, 10);
+  if ((*end != '\0') || (end == val)) return false;
+
+  if      (strcmp(key, "period") == 0) cfg->period = v;
+  else if (strcmp(key, "window") == 0) cfg->window = v;
+  else if (strcmp(key, "warmup") == 0) cfg->warmup = v;
+  else return false;
+
+  return true;
+}
+
+bool sample_parse(const char *spec, SampleConfig *cfg)
+{
+  if (!parse_options(spec, parse_option, cfg, "sampling")) return false;
+
+  if ((cfg->window == 0) || (cfg->warmup + cfg->window > cfg->period)) {
+    cout << "sampling window and warm-up must fit into the period" << endl;
+    return false;
+  }
+  return true;
+}
+
+
+//------------------------------------------------------------------------------
+// SampledReplay
+//
+SampledReplay::SampledReplay(Disk *disk, const SampleConfig &cfg)
+  : _cfg(cfg), _replay(disk), _requests(0), _detailed(0),
+    _first(0), _last(0)
+{
+}
+
+void SampledReplay::run(Workload *wl)
+{
+  Request req;
+  SimTime busy = 0;
+
+  _recent.assign(_cfg.window, 0);
+
+  while (wl->next(&req)) {
+    if (_requests == 0) _first = req.ts;
+    uint64 phase = _requests % _cfg.period;
+    _requests++;
+
+    SimTime end;
+    if (phase < _cfg.warmup + _cfg.window) {
+      // detailed simulation; only the window is measured
+      if (phase == _cfg.warmup) _replay.reset();
+      end = _replay.submit(req, req.ts);
+      _detailed++;
+      if (phase >= _cfg.warmup) {
+        // the disk serves the requests in order: this one starts when it
+        // arrives or when the previous one completes
+        SimTime start = req.ts > busy ? req.ts : busy;
+        _recent[phase - _cfg.warmup] = end - start;
+        _samples.push_back((float)sim_seconds(end - req.ts));
+      }
+
+      if (phase == _cfg.warmup + _cfg.window - 1) {
+        _service.merge(_replay.service());
+        _response.merge(_replay.response());
+        _svc_mean.push_back(_replay.service().mean());
+        _resp_mean.push_back(_replay.response().mean());
+      }
+    } else {
+      // fast-forward, replaying the service times of the last window so
+      // that the queue sees their variability, not only their mean
+      end = _replay.skip(req, req.ts, _recent[phase % _recent.size()]);
+    }
+
+    busy = end;
+    if (end > _last) _last = end;
+  }
+}
+
+double SampledReplay::metric(SampleMetric m, const LatencyStats &service,
+                             const LatencyStats &response)
+{
+  switch (m) {
+    case SM_SERVICE_MEAN:  return service.mean();
+    case SM_RESPONSE_MEAN: return response.mean();
+    case SM_RESPONSE_P50:  return response.percentile(50.0);
+    case SM_RESPONSE_P90:  return response.percentile(90.0);
+    case SM_RESPONSE_P99:  return response.percentile(99.0);
+    default:               return 0.0;
+  }
+}
+
+double SampledReplay::estimate(SampleMetric m) const
+{
+  return metric(m, _service, _response);
+}
+
+void SampledReplay::batch_interval(const vector<double> &v, double *mean,
+                                   double *half)
+{
+  size_t n = v.size();
+  double m = 0.0, var = 0.0;
+  for (size_t i=0; i<n; i++) m += v[i];
+  m = n > 0 ? m / n : 0.0;
+  for (size_t i=0; i<n; i++) var += (v[i] - m) * (v[i] - m);
+
+  *mean = m;
+  *half = 0.0;
+  if (n >= 2) {
+    double t = n - 1 <= 30 ? t95[n - 2] : 1.960;
+    *half = t * sqrt(var / (n - 1) / n);
+  }
+}
+
+void SampledReplay::interval(SampleMetric m, double *lo, double *hi) const
+{
+  double e = estimate(m), mean, half;
+  *lo = *hi = e;
+  if (windows() < 2) return;
+
+  if (m == SM_SERVICE_MEAN || m == SM_RESPONSE_MEAN) {
+    batch_interval(m == SM_SERVICE_MEAN ? _svc_mean : _resp_mean, &mean, &half);
+    *lo = e - half;
+    *hi = e + half;
+    return;
+  }
+
+  // fraction of each window's samples at or below the estimate
+  vector<double> below(windows());
+  for (size_t w=0; w<below.size(); w++) {
+    size_t n = 0;
+    for (size_t i=w*_cfg.window; i<(w+1)*_cfg.window; i++) {
+      n += _samples[i] <= e;
+    }
+    below[w] = (double)n / _cfg.window;
+  }
+  batch_interval(below, &mean, &half);
+
+  double p = m == SM_RESPONSE_P50 ? 50.0 : m == SM_RESPONSE_P90 ? 90.0 : 99.0;
+  double plo = p - 100.0 * half, phi = p + 100.0 * half;
+  *lo = _response.percentile(plo > 0.0 ? plo : 0.0);
+  *hi = _response.percentile(phi < 100.0 ? phi : 100.0);
+  if (*lo > e) *lo = e;
+  if (*hi < e) *hi = e;
+}
+
+void SampledReplay::report(ostream &os, const Replay *full) const
+{
+  double pct = _requests > 0 ? 100.0 * _detailed / _requests : 0.0;
+
+  os.precision(6);
+  os << "sampled replay (period " << _cfg.period << ", window " << _cfg.window
+     << ", warm-up " << _cfg.warmup << "):" << endl
+     << "  requests:    " << _requests << " (" << _service.count()
+     << " measured in " << windows() << " windows, " << setprecision(1)
+     << dec << fixed << pct << "% simulated in detail)" << endl
+     << setprecision(6)
+     << "  elapsed:     " << elapsed() << " (estimated)" << endl
+     << "  iops:        " << (elapsed() > 0.0 ? _requests / elapsed() : 0.0)
+     << " (estimated)" << endl
+     << "                      estimate     95% CI low    95% CI high";
+  if (full) os << "          full    error";
+  os << endl;
+
+  for (int m=0; m<SM_METRICS; m++) {
+    double e = estimate((SampleMetric)m), lo, hi;
+    interval((SampleMetric)m, &lo, &hi);
+    os << "  " << left << setw(14) << metric_name[m] << right
+       << setprecision(6) << setw(14) << e << setw(15) << lo << setw(15) << hi;
+    if (full) {
+      double f = metric((SampleMetric)m, full->service(), full->response());
+      os << setw(14) << f << setprecision(1) << setw(8)
+         << (f > 0.0 ? 100.0 * (e - f) / f : 0.0) << "%"
+         << ((lo <= f) && (f <= hi) ? "" : " (outside CI)");
+    }
+    os << endl;
+  }
+  os << endl;
+}
@@ -0,0 +1,172 @@
+//------------------------------------------------------------------------------
+/// @brief sampled (fast-forward) replay
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_SAMPLE_H__
+#define __CA_SAMPLE_H__
+
+#include <iostream>
+#include <vector>
+
+#include "disk.h"
+#include "replay.h"
+#include "stats.h"
+#include "workload.h"
+using namespace std;
+
+//------------------------------------------------------------------------------
+/// @brief configuration of a sampled replay
+///
+/// The request stream is divided into periods of @a period requests. The
+/// first @a warmup requests of a period are simulated in detail to
+/// re-establish the state of the disk and the queue, the following @a window
+/// requests are simulated in detail and measured, and the rest of the period
+/// is fast-forwarded. A configuration is parsed from a comma-separated list of
+/// key=value pairs:
+///
+/// - period=<n>                     requests per period
+/// - window=<n>                     measured requests per period
+/// - warmup=<n>                     detailed, unmeasured requests per period
+/// - full=0|1                       also run a full replay for validation
+///
+typedef struct _sample_config {
+  uint64 period;                    ///< requests per period
+  uint64 window;                    ///< measured requests per period
+  uint64 warmup;                    ///< warm-up requests per period
+  bool   full;                      ///< validate against a full replay
+} SampleConfig;
+
+/// @brief initialize @a cfg with default values
+void sample_defaults(SampleConfig *cfg);
+
+/// @brief parse @a spec into @a cfg (on top of the values already in @a cfg)
+/// @retval true if @a spec was parsed successfully, false otherwise
+bool sample_parse(const char *spec, SampleConfig *cfg);
+
+
+/// @brief estimated quantities of a sampled replay
+typedef enum {
+  SM_SERVICE_MEAN,                  ///< mean service time
+  SM_RESPONSE_MEAN,                 ///< mean response time
+  SM_RESPONSE_P50,                  ///< median response time
+  SM_RESPONSE_P90,                  ///< 90th percentile of the response time
+  SM_RESPONSE_P99,                  ///< 99th percentile of the response time
+  SM_METRICS                        ///< number of estimated quantities
+} SampleMetric;
+
+
+//------------------------------------------------------------------------------
+/// @brief sampled replay of request streams against a disk
+///
+/// SampledReplay runs an open-loop replay in which only periodic windows of
+/// the stream are simulated in detail (systematic sampling). Fast-forwarded
+/// requests only warm the state of the disk (see Disk::warm()) and occupy the
+/// queue for the mean service time measured so far, so a long stream is
+/// replayed at a fraction of the cost of a full replay.
+///
+/// The estimates are computed from the pooled samples of all windows. Their
+/// confidence intervals treat the windows as batches: for means, the spread
+/// of the per-window means gives the interval with Student's t distribution;
+/// for percentiles, the same is done for the fraction of each window's
+/// samples below the estimate, and the interval of the fraction is mapped
+/// back to response times through the pooled distribution. The intervals are
+/// only meaningful if there are at least a few windows and the windows are
+/// far enough apart to be roughly independent.
+///
+class SampledReplay {
+  public:
+    /// @name constructor/destructor
+    /// @{
+
+    /// @brief constructor
+    /// @param disk disk to serve the requests
+    /// @param cfg sampling configuration
+    SampledReplay(Disk *disk, const SampleConfig &cfg);
+
+    /// @}
+
+
+    /// @name replay
+    /// @{
+
+    /// @brief sampled open-loop replay of @a wl
+    void   run(Workload *wl);
+
+    /// @}
+
+
+    /// @name results
+    /// @{
+
+    uint64 requests(void) const { return _requests; } ///< # requests
+    uint64 detailed(void) const { return _detailed; } ///< # detailed requests
+    uint64 windows(void) const { return _svc_mean.size(); } ///< # windows
+    double elapsed(void) const { return sim_seconds(_last - _first); } ///< est.
+
+    /// @brief estimate of @a m from all windows
+    double estimate(SampleMetric m) const;
+
+    /// @brief 95% confidence interval [@a lo, @a hi] of @a m. The interval
+    ///        is empty (@a lo = @a hi = estimate) with fewer than two windows.
+    void   interval(SampleMetric m, double *lo, double *hi) const;
+
+    /// @brief print the estimates to @a os. With @a full, the results of a
+    ///        full replay of the same stream are shown for comparison.
+    void   report(ostream &os, const Replay *full=NULL) const;
+
+    /// @}
+
+
+  protected:
+    SampleConfig _cfg;              ///< configuration
+    Replay _replay;                 ///< replay of the detailed requests
+    uint64 _requests;               ///< number of requests
+    uint64 _detailed;               ///< number of requests simulated in detail
+    SimTime _first;                 ///< arrival time of the first request
+    SimTime _last;                  ///< completion time of the last request
+    LatencyStats _service;          ///< service times of all windows
+    LatencyStats _response;         ///< response times of all windows
+    vector<double> _svc_mean;       ///< mean service time of each window
+    vector<double> _resp_mean;      ///< mean response time of each window
+    vector<float>  _samples;        ///< response times of all windows
+    vector<SimTime> _recent;        ///< service times of the last window
+
+    /// @brief the value of @a m for the given statistics
+    static double metric(SampleMetric m, const LatencyStats &service,
+                         const LatencyStats &response);
+
+    /// @brief mean and half width of the 95% confidence interval of the
+    ///        batch values @a v
+    static void   batch_interval(const vector<double> &v, double *mean,
+                                 double *half);
+};
+
+#endif // __CA_SAMPLE_H__
@@ -0,0 +1,609 @@
+//------------------------------------------------------------------------------
+/// @brief simulator service over a Unix domain socket
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+#include <iostream>
+#include <iomanip>
+#include <map>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "service.h"
+#include "options.h"
+#include "stats.h"
+using namespace std;
+
+//------------------------------------------------------------------------------
+// helpers
+//
+static volatile sig_atomic_t stop_requested = 0;
+
+static void on_signal(int)
+{
+  stop_requested = 1;
+}
+
+/// read exactly @a len bytes from @a fd
+static bool read_full(int fd, void *buf, size_t len)
+{
+  char *p = (char*)buf;
+  while (len > 0) {
+    ssize_t n = read(fd, p, len);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) return false;
+    p += n;
+    len -= n;
+  }
+  return true;
+}
+
+/// write exactly @a len bytes to @a fd
+static bool write_full(int fd, const void *buf, size_t len)
+{
+  const char *p = (const char*)buf;
+  while (len > 0) {
+    ssize_t n = write(fd, p, len);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) return false;
+    p += n;
+    len -= n;
+  }
+  return true;
+}
+
+static bool make_address(const char *path, struct sockaddr_un *addr)
+{
+  memset(addr, 0, sizeof(*addr));
+  addr->sun_family = AF_UNIX;
+  if (strlen(path) >= sizeof(addr->sun_path)) {
+    cout << "socket path too long: " << path << endl;
+    return false;
+  }
+  strcpy(addr->sun_path, path);
+  return true;
+}
+
+static double now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+
+//------------------------------------------------------------------------------
+/// @brief a simulated device of the service
+///
+typedef struct _svc_device {
+  dl_hdd *hdd;                      ///< simulated HDD
+  mutex   lock;                     ///< serializes accesses to the HDD
+} SvcDevice;
+
+
+//------------------------------------------------------------------------------
+/// @brief the simulator service
+///
+/// The main thread polls the listening socket and all idle connections. A
+/// connection with a pending message is handed to the worker pool; after
+/// the worker has replied, the connection is returned to the main thread
+/// through a pipe.
+///
+class Service {
+  public:
+    Service(void);
+    ~Service(void);
+
+    /// @brief serve clients on @a listen_fd with @a threads workers
+    void run(int listen_fd, uint32 threads);
+
+  protected:
+    map<uint32, shared_ptr<SvcDevice> > _devices;  ///< devices by id
+    uint32 _next_id;                ///< id of the next device
+    mutex  _dev_lock;               ///< protects _devices and _next_id
+
+    deque<int> _ready;              ///< connections with a pending message
+    vector<int> _returned;          ///< connections handled by a worker
+    bool   _stop;                   ///< workers terminate
+    mutex  _lock;                   ///< protects _ready, _returned, _stop
+    condition_variable _cv;         ///< signals _ready and _stop
+    int    _wake[2];                ///< pipe to wake up the main thread
+
+    /// @brief worker thread
+    void   worker(void);
+
+    /// @brief handle one message on connection @a fd
+    /// @retval true if the connection stays open, false otherwise
+    bool   handle(int fd);
+
+    /// @brief device with id @a id, NULL if there is no such device
+    shared_ptr<SvcDevice> device(uint32 id);
+};
+
+Service::Service(void)
+  : _next_id(1), _stop(false)
+{
+  _wake[0] = _wake[1] = -1;
+}
+
+Service::~Service(void)
+{
+  map<uint32, shared_ptr<SvcDevice> >::iterator it;
+  for (it = _devices.begin(); it != _devices.end(); it++) {
+    dl_hdd_destroy(it->second->hdd);
+  }
+}
+
+shared_ptr<SvcDevice> Service::device(uint32 id)
+{
+  lock_guard<mutex> g(_dev_lock);
+  map<uint32, shared_ptr<SvcDevice> >::iterator it = _devices.find(id);
+  if (it == _devices.end()) return shared_ptr<SvcDevice>();
+  return it->second;
+}
+
+bool Service::handle(int fd)
+{
+  SvcHeader hdr, rep;
+  if (!read_full(fd, &hdr, sizeof(hdr)) || (hdr.magic != SVC_MAGIC)) {
+    return false;
+  }
+
+  rep.magic  = SVC_MAGIC;
+  rep.op     = SVC_OK;
+  rep.device = hdr.device;
+  rep.count  = 0;
+
+  switch (hdr.op) {
+    case SVC_CREATE: {
+      dl_geometry geo;
+      if (!read_full(fd, &geo, sizeof(geo))) return false;
+
+      dl_hdd *hdd = dl_hdd_create(&geo);
+      if (hdd == NULL) {
+        rep.op = SVC_EINVAL;
+        return write_full(fd, &rep, sizeof(rep));
+      }
+
+      shared_ptr<SvcDevice> dev(new SvcDevice);
+      dev->hdd = hdd;
+      {
+        lock_guard<mutex> g(_dev_lock);
+        rep.device = _next_id++;
+        _devices[rep.device] = dev;
+      }
+      return write_full(fd, &rep, sizeof(rep));
+    }
+
+    case SVC_SUBMIT: {
+      if (hdr.count > SVC_MAX_BATCH) return false;
+
+      vector<dl_request> req(hdr.count);
+      if (!read_full(fd, req.data(), hdr.count * sizeof(dl_request))) {
+        return false;
+      }
+
+      shared_ptr<SvcDevice> dev = device(hdr.device);
+      if (!dev) {
+        rep.op = SVC_ENODEV;
+        return write_full(fd, &rep, sizeof(rep));
+      }
+
+      size_t served;
+      {
+        // the device may have been destroyed since it was looked up
+        lock_guard<mutex> g(dev->lock);
+        if (dev->hdd == NULL) {
+          rep.op = SVC_ENODEV;
+          return write_full(fd, &rep, sizeof(rep));
+        }
+        served = dl_hdd_submit_batch(dev->hdd, req.data(), req.size());
+      }
+      vector<double> done(served);
+      for (size_t i=0; i<served; i++) done[i] = req[i].completion;
+
+      if (served < hdr.count) rep.op = SVC_EINVAL;
+      rep.count = (uint32)served;
+      return write_full(fd, &rep, sizeof(rep)) &&
+             write_full(fd, done.data(), done.size() * sizeof(double));
+    }
+
+    case SVC_STATS: {
+      shared_ptr<SvcDevice> dev = device(hdr.device);
+      if (!dev) {
+        rep.op = SVC_ENODEV;
+        return write_full(fd, &rep, sizeof(rep));
+      }
+
+      dl_stats stats;
+      {
+        lock_guard<mutex> g(dev->lock);
+        if (dev->hdd == NULL) {
+          rep.op = SVC_ENODEV;
+          return write_full(fd, &rep, sizeof(rep));
+        }
+        dl_hdd_stats(dev->hdd, &stats);
+      }
+      return write_full(fd, &rep, sizeof(rep)) &&
+             write_full(fd, &stats, sizeof(stats));
+    }
+
+    case SVC_DESTROY: {
+      shared_ptr<SvcDevice> dev;
+      {
+        lock_guard<mutex> g(_dev_lock);
+        map<uint32, shared_ptr<SvcDevice> >::iterator it;
+        it = _devices.find(hdr.device);
+        if (it != _devices.end()) {
+          dev = it->second;
+          _devices.erase(it);
+        }
+      }
+      if (!dev) {
+        rep.op = SVC_ENODEV;
+      } else {
+        lock_guard<mutex> g(dev->lock);
+        dl_hdd_destroy(dev->hdd);
+        dev->hdd = NULL;
+      }
+      return write_full(fd, &rep, sizeof(rep));
+    }
+
+    default:
+      return false;
+  }
+}
+
+void Service::worker(void)
+{
+  while (true) {
+    int fd;
+    {
+      unique_lock<mutex> g(_lock);
+      while (_ready.empty() && !_stop) _cv.wait(g);
+      if (_stop) return;
+      fd = _ready.front();
+      _ready.pop_front();
+    }
+
+    if (handle(fd)) {
+      lock_guard<mutex> g(_lock);
+      _returned.push_back(fd);
+    } else {
+      close(fd);
+    }
+
+    char c = 0;
+    write_full(_wake[1], &c, 1);
+  }
+}
+
+void Service::run(int listen_fd, uint32 threads)
+{
+  if (pipe(_wake) != 0) {
+    cout << "cannot create pipe: " << strerror(errno) << endl;
+    return;
+  }
+  fcntl(_wake[0], F_SETFL, O_NONBLOCK);
+
+  vector<thread> pool;
+  for (uint32 i=0; i<threads; i++) {
+    pool.push_back(thread(&Service::worker, this));
+  }
+
+  vector<int> idle;
+  vector<struct pollfd> pfd;
+
+  while (!stop_requested) {
+    pfd.clear();
+    struct pollfd p;
+    p.events = POLLIN;
+    p.revents = 0;
+    p.fd = listen_fd; pfd.push_back(p);
+    p.fd = _wake[0];  pfd.push_back(p);
+    for (size_t i=0; i<idle.size(); i++) { p.fd = idle[i]; pfd.push_back(p); }
+
+    if (poll(pfd.data(), pfd.size(), -1) < 0) {
+      if (errno == EINTR) continue;
+      cout << "poll failed: " << strerror(errno) << endl;
+      break;
+    }
+
+    // connections with a pending message go to the workers
+    vector<int> still_idle;
+    for (size_t i=0; i<idle.size(); i++) {
+      if (pfd[i+2].revents != 0) {
+        lock_guard<mutex> g(_lock);
+        _ready.push_back(idle[i]);
+        _cv.notify_one();
+      } else {
+        still_idle.push_back(idle[i]);
+      }
+    }
+    idle.swap(still_idle);
+
+    // connections returned by the workers
+    if (pfd[1].revents != 0) {
+      char buf[256];
+      while (read(_wake[0], buf, sizeof(buf)) > 0);
+      lock_guard<mutex> g(_lock);
+      idle.insert(idle.end(), _returned.begin(), _returned.end());
+      _returned.clear();
+    }
+
+    // new connections
+    if (pfd[0].revents != 0) {
+      int fd = accept(listen_fd, NULL, NULL);
+      if (fd >= 0) idle.push_back(fd);
+    }
+  }
+
+  {
+    lock_guard<mutex> g(_lock);
+    _stop = true;
+    _cv.notify_all();
+  }
+  for (size_t i=0; i<pool.size(); i++) pool[i].join();
+
+  for (size_t i=0; i<idle.size(); i++) close(idle[i]);
+  for (size_t i=0; i<_ready.size(); i++) close(_ready[i]);
+  for (size_t i=0; i<_returned.size(); i++) close(_returned[i]);
+  close(_wake[0]);
+  close(_wake[1]);
+}
+
+/// parse a positive count
+static bool parse_count(const char *val, uint32 *n)
+{
+  char *end;
+  unsigned long v = strtoul(val, &end, 10);
+  *n = (uint32)v;
+  return (end != val) && (*end == '\0') && (v > 0) && (v <= 0xffffffffUL);
+}
+
+static bool parse_service_option(const char *key, const char *val, void *ctx)
+{
+  if (strcmp(key, "threads") == 0) return parse_count(val, (uint32*)ctx);
+  return false;
+}
+
+static bool parse_load_option(const char *key, const char *val, void *ctx)
+{
+  SvcLoadConfig *cfg = (SvcLoadConfig*)ctx;
+
+  if (strcmp(key, "clients") == 0) return parse_count(val, &cfg->clients);
+  if (strcmp(key, "batches") == 0) return parse_count(val, &cfg->batches);
+  if (strcmp(key, "batch") == 0) {
+    return parse_count(val, &cfg->batch) && (cfg->batch <= SVC_MAX_BATCH);
+  }
+  return false;
+}
+
+/// split "<path>[,options]" into @a path and the options, and parse these
+static bool parse_spec(const char *spec, string *path, OptionHandler handler,
+                       void *ctx, const char *what)
+{
+  const char *comma = strchr(spec, ',');
+  *path = comma ? string(spec, comma - spec) : string(spec);
+  if (path->empty()) {
+    cout << "no socket path in the " << what << " specification" << endl;
+    return false;
+  }
+  return (comma == NULL) || parse_options(comma + 1, handler, ctx, what);
+}
+
+bool service_parse(const char *spec, string *path, uint32 *threads)
+{
+  return parse_spec(spec, path, parse_service_option, threads, "service");
+}
+
+void service_load_defaults(SvcLoadConfig *cfg)
+{
+  cfg->clients = 4;
+  cfg->batches = 1000;
+  cfg->batch   = 64;
+}
+
+bool service_load_parse(const char *spec, string *path, SvcLoadConfig *cfg)
+{
+  return parse_spec(spec, path, parse_load_option, cfg, "load test");
+}
+
+bool service_run(const char *path, uint32 threads)
+{
+  struct sockaddr_un addr;
+  if (!make_address(path, &addr)) return false;
+
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0) {
+    cout << "cannot create socket: " << strerror(errno) << endl;
+    return false;
+  }
+
+  unlink(path);
+  if ((bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) ||
+      (listen(fd, 64) != 0)) {
+    cout << "cannot listen on " << path << ": " << strerror(errno) << endl;
+    close(fd);
+    return false;
+  }
+
+  // terminate on SIGINT/SIGTERM; poll() must be interrupted, so no SA_RESTART
+  struct sigaction sa;
+  memset(&sa, 0, sizeof(sa));
+  sa.sa_handler = on_signal;
+  sigaction(SIGINT, &sa, NULL);
+  sigaction(SIGTERM, &sa, NULL);
+  signal(SIGPIPE, SIG_IGN);
+
+  cout << "service: listening on " << path << " with " << threads
+       << " worker threads" << endl;
+
+  Service svc;
+  svc.run(fd, threads);
+
+  close(fd);
+  unlink(path);
+  cout << "service: terminated" << endl;
+  return true;
+}
+
+
+//------------------------------------------------------------------------------
+// load-test client
+//
+
+/// send a message and receive the reply header
+static bool transact(int fd, SvcHeader *hdr, const void *payload, size_t len)
+{
+  hdr->magic = SVC_MAGIC;
+  if (!write_full(fd, hdr, sizeof(*hdr))) return false;
+  if ((len > 0) && !write_full(fd, payload, len)) return false;
+  if (!read_full(fd, hdr, sizeof(*hdr))) return false;
+  return (hdr->magic == SVC_MAGIC) && (hdr->op == SVC_OK);
+}
+
+static bool load_client(const char *path, const dl_geometry &geo,
+                        WorkloadConfig wcfg, const SvcLoadConfig &cfg,
+                        uint32 client, LatencyStats *rtt)
+{
+  struct sockaddr_un addr;
+  if (!make_address(path, &addr)) return false;
+
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if ((fd < 0) || (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0)) {
+    cout << "cannot connect to " << path << ": " << strerror(errno) << endl;
+    if (fd >= 0) close(fd);
+    return false;
+  }
+
+  // own device with its own request stream
+  SvcHeader hdr;
+  hdr.op = SVC_CREATE;
+  hdr.device = hdr.count = 0;
+  bool ok = transact(fd, &hdr, &geo, sizeof(geo));
+  uint32 dev = hdr.device;
+
+  dl_hdd *local = dl_hdd_create(&geo);
+  uint64 capacity = local ? dl_hdd_capacity(local) : 0;
+  dl_hdd_destroy(local);
+  wcfg.seed += client;
+  wcfg.count = (uint64)cfg.batches * cfg.batch;
+  SyntheticWorkload wl(wcfg, capacity, geo.sector_size);
+
+  vector<dl_request> req(cfg.batch);
+  vector<double> done(cfg.batch);
+
+  for (uint32 b=0; ok && (b<cfg.batches); b++) {
+    Request r;
+    for (uint32 i=0; i<cfg.batch; i++) {
+      wl.next(&r);
+      req[i].ts       = sim_seconds(r.ts);
+      req[i].rw       = r.rw == 'w' ? DL_WRITE : DL_READ;
+      req[i].reserved = 0;
+      req[i].address  = r.address;
+      req[i].size     = r.size;
+    }
+
+    double start = now();
+    hdr.op = SVC_SUBMIT;
+    hdr.device = dev;
+    hdr.count = cfg.batch;
+    ok = transact(fd, &hdr, req.data(), req.size() * sizeof(dl_request)) &&
+         (hdr.count == cfg.batch) &&
+         read_full(fd, done.data(), done.size() * sizeof(double));
+    rtt->add(now() - start);
+  }
+
+  hdr.op = SVC_DESTROY;
+  hdr.device = dev;
+  hdr.count = 0;
+  ok = transact(fd, &hdr, NULL, 0) && ok;
+
+  close(fd);
+  return ok;
+}
+
+bool service_load(const char *path, const dl_geometry &geo,
+                  const WorkloadConfig &wcfg, const SvcLoadConfig &cfg)
+{
+  signal(SIGPIPE, SIG_IGN);
+
+  vector<LatencyStats> rtt(cfg.clients);
+  vector<char> ok(cfg.clients, 0);
+  vector<thread> clients;
+
+  double start = now();
+  for (uint32 c=0; c<cfg.clients; c++) {
+    clients.push_back(thread([&, c]() {
+      ok[c] = load_client(path, geo, wcfg, cfg, c, &rtt[c]);
+    }));
+  }
+  for (uint32 c=0; c<cfg.clients; c++) clients[c].join();
+  double elapsed = now() - start;
+
+  LatencyStats total;
+  bool all_ok = true;
+  for (uint32 c=0; c<cfg.clients; c++) {
+    total.merge(rtt[c]);
+    all_ok = all_ok && ok[c];
+  }
+
+  cout.precision(3);
+  cout << "load test: " << endl
+       << "  clients:     " << cfg.clients << endl
+       << "  batches:     " << cfg.batches << " x " << cfg.batch
+       << " requests per client" << endl
+       << "  elapsed:     " << dec << fixed << elapsed << endl
+       << "  queries/s:   " << total.count() / elapsed << endl
+       << "  requests/s:  " << total.count() * cfg.batch / elapsed << endl;
+  total.print(cout, "round trip");
+  cout << endl;
+
+  if (!all_ok) cout << "load test: some requests failed" << endl;
+  return all_ok;
+}
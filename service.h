@@ -0,0 +1,123 @@
+//------------------------------------------------------------------------------
+/// @brief simulator service over a Unix domain socket
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_SERVICE_H__
+#define __CA_SERVICE_H__
+
+#include <string>
+
+#include "disk.h"
+#include "disklab.h"
+#include "workload.h"
+using namespace std;
+
+//------------------------------------------------------------------------------
+// protocol
+//
+// Every message starts with a SvcHeader followed by a payload. All values are
+// in host byte order (the socket is local).
+//
+//   op          request payload           reply payload
+//   SVC_CREATE  dl_geometry               -  (header.device = new device id)
+//   SVC_SUBMIT  count x dl_request        count x double (completion times)
+//   SVC_STATS   -                         dl_stats
+//   SVC_DESTROY -                         -
+//
+// A reply carries the status of the request in header.op. If a request of a
+// batch is invalid (see dl_hdd_submit_batch()), SVC_SUBMIT replies SVC_EINVAL
+// with the completion times of the header.count requests served before it.
+//
+#define SVC_MAGIC      0x444c6162   ///< "DLab"
+#define SVC_MAX_BATCH  (1 << 20)    ///< maximal number of requests per batch
+
+#define SVC_CREATE     1            ///< create a device
+#define SVC_SUBMIT     2            ///< submit a batch of requests
+#define SVC_STATS      3            ///< read the statistics of a device
+#define SVC_DESTROY    4            ///< destroy a device
+
+#define SVC_OK         0            ///< status: success
+#define SVC_EINVAL     1            ///< status: invalid request
+#define SVC_ENODEV     2            ///< status: no such device
+
+///@brief message header
+typedef struct _svc_header {
+  uint32 magic;                     ///< SVC_MAGIC
+  uint32 op;                        ///< operation (request) or status (reply)
+  uint32 device;                    ///< device id
+  uint32 count;                     ///< number of requests in the payload
+} SvcHeader;
+
+
+//------------------------------------------------------------------------------
+/// @brief run the simulator service
+///
+/// The service listens on the Unix domain socket @a path and serves clients
+/// until it receives SIGINT or SIGTERM. Devices stay alive between messages
+/// and connections. Each message is handled by one of @a threads worker
+/// threads; messages to different devices are processed in parallel.
+///
+/// @retval true if the service terminated normally, false on error
+bool service_run(const char *path, uint32 threads);
+
+/// @brief parse the service specification "<path>[,threads=<n>]" into
+///        @a path and @a threads
+/// @retval true if @a spec was parsed successfully, false otherwise
+bool service_parse(const char *spec, string *path, uint32 *threads);
+
+
+///@brief parameters of the load-test client
+typedef struct _svc_load_config {
+  uint32 clients;                   ///< number of concurrent clients
+  uint32 batches;                   ///< number of batches per client
+  uint32 batch;                     ///< number of requests per batch
+} SvcLoadConfig;
+
+/// @brief initialize @a cfg with default values
+void service_load_defaults(SvcLoadConfig *cfg);
+
+/// @brief parse the load-test specification
+///        "<path>[,clients=<n>,batches=<n>,batch=<n>]" into @a path and @a cfg
+///        (on top of the values already in @a cfg)
+/// @retval true if @a spec was parsed successfully, false otherwise
+bool service_load_parse(const char *spec, string *path, SvcLoadConfig *cfg);
+
+/// @brief run the load-test client against the service at @a path
+///
+/// Each client connects, creates its own device with geometry @a geo, and
+/// submits @a cfg.batches batches of requests generated from @a wcfg. The
+/// round-trip latency of the batches and the throughput are printed.
+///
+/// @retval true if all requests succeeded, false otherwise
+bool service_load(const char *path, const dl_geometry &geo,
+                  const WorkloadConfig &wcfg, const SvcLoadConfig &cfg);
+
+#endif // __CA_SERVICE_H__
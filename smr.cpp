@@ -0,0 +1,402 @@
+//------------------------------------------------------------------------------
+/// @brief shingled magnetic recording (SMR) HDDs
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <cstdio>
+#include <cstring>
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+#include "smr.h"
+#include "options.h"
+#include "snapshot.h"
+using namespace std;
+
+//------------------------------------------------------------------------------
+// SMRConfig
+//
+void smr_defaults(SMRConfig *cfg)
+{
+  cfg->host_managed = false;
+  cfg->zone_tracks  = 4;
+  cfg->mc_size      = 1ULL << 30;
+  cfg->clean_idle   = 1.0;
+  cfg->full         = false;
+}
+
+static bool parse_option(const char *key, const char *val, void *ctx)
+{
+  SMRConfig *cfg = (SMRConfig*)ctx;
+
+  if (strcmp(key, "mode") == 0) {
+    if (strcmp(val, "hm") == 0) { cfg->host_managed = true; return true; }
+    if (strcmp(val, "dm") == 0) { cfg->host_managed = false; return true; }
+    return false;
+  }
+  if (strcmp(key, "zone") == 0) {
+    return sscanf(val, "%u", &cfg->zone_tracks) == 1 && cfg->zone_tracks > 0;
+  }
+  if (strcmp(key, "mc") == 0) {
+    return parse_size(val, &cfg->mc_size) && cfg->mc_size > 0;
+  }
+  if (strcmp(key, "idle") == 0) {
+    return sscanf(val, "%lf", &cfg->clean_idle) == 1;
+  }
+  if (strcmp(key, "wp") == 0) {
+    if (strcmp(val, "empty") == 0) { cfg->full = false; return true; }
+    if (strcmp(val, "full") == 0)  { cfg->full = true; return true; }
+    return false;
+  }
+
+  return false;
+}
+
+bool smr_parse(const char *spec, SMRConfig *cfg)
+{
+  return parse_options(spec, parse_option, cfg, "SMR");
+}
+
+
+//------------------------------------------------------------------------------
+// SMRHDD
+//
+SMRHDD::SMRHDD(uint32 surfaces, uint32 tracks_per_surface,
+               uint32 sectors_innermost_track, uint32 sectors_outermost_track,
+               uint32 rpm, uint32 sector_size,
+               double seek_overhead, double seek_per_track,
+               const SMRConfig &cfg)
+  : HDD(surfaces, tracks_per_surface,
+        sectors_innermost_track, sectors_outermost_track,
+        rpm, sector_size, seek_overhead, seek_per_track),
+    _cfg(cfg), _clean_idle(sim_time(cfg.clean_idle)),
+    _mc_head(0), _mc_used(0), _busy_until(0),
+    _seq_writes(0), _rmw_writes(0), _rmw_bytes(0), _mc_writes(0),
+    _mc_reads(0), _bg_cleans(0), _fg_cleans(0),
+    _clean_time(0), _fg_clean_time(0)
+{
+  // the media cache occupies the outermost tracks (drive-managed only)
+  uint64 cap = capacity();
+  uint64 mc  = cfg.host_managed ? 0 : min(cfg.mc_size, cap / 2);
+  _cfg.mc_size = mc;
+  _mc_start = (cap - mc) / _sector_size * _sector_size;
+
+  // zones of zone_tracks tracks (on all surfaces) below the media cache
+  uint64 adr = 0;
+  for (uint32 t=0; (t<tracks_per_sf) && (adr<_mc_start); t++) {
+    if (t % cfg.zone_tracks == 0) _zone_start.push_back(adr);
+    adr += (uint64)_surfaces * num_of_sector(t) * _sector_size;
+  }
+  _zone_start.push_back(_mc_start);
+
+  uint32 zones = _zone_start.size() - 1;
+  _wp.resize(zones);
+  for (uint32 z=0; z<zones; z++) {
+    _wp[z] = cfg.full ? _zone_start[z+1] - _zone_start[z] : 0;
+  }
+  _mc_bytes.assign(zones, 0);
+  _mc.resize(zones);
+}
+
+SMRHDD::~SMRHDD(void)
+{
+}
+
+uint32 SMRHDD::zone_of(uint64 address) const
+{
+  return upper_bound(_zone_start.begin(), _zone_start.end(), address) -
+         _zone_start.begin() - 1;
+}
+
+SimTime SMRHDD::read(SimTime ts, uint64 address, uint64 size)
+{
+  SimTime t = clean_idle(ts);
+  t = HDD::read(t, address, size);
+
+  // newer data in the media cache is read from there
+  uint64 end = address + size;
+  for (uint32 z=zone_of(address); (z<_mc.size()) && (_zone_start[z]<end); z++) {
+    for (size_t i=0; i<_mc[z].size(); i++) {
+      const MCExtent &e = _mc[z][i];
+      uint64 lo = max(e.address, address);
+      uint64 hi = min(e.address + e.size, end);
+      if (lo < hi) {
+        t = HDD::read(t, e.mc_address + (lo - e.address), hi - lo);
+        _mc_reads++;
+      }
+    }
+  }
+
+  _busy_until = t;
+  return t;
+}
+
+SimTime SMRHDD::write(SimTime ts, uint64 address, uint64 size)
+{
+  SimTime t = clean_idle(ts);
+
+  // split the request at zone boundaries
+  uint64 end = address + size;
+  while (address < end) {
+    uint32 z = zone_of(address);
+    if (z >= _wp.size()) {
+      // beyond the zones (media cache area): conventional write
+      t = HDD::write(t, address, end - address);
+      break;
+    }
+    uint64 n = min(end, _zone_start[z+1]) - address;
+    t = write_zone(t, z, address, n);
+    address += n;
+  }
+
+  _busy_until = t;
+  return t;
+}
+
+SimTime SMRHDD::write_zone(SimTime ts, uint32 z, uint64 address, uint64 size)
+{
+  uint64 zs  = _zone_start[z];
+  uint64 off = address - zs;
+  uint64 wp  = _wp[z];
+  SimTime t;
+
+  if (off >= wp) {
+    // sequential write at (or beyond) the write pointer
+    t = HDD::write(ts, address, size);
+    _wp[z] = off + size;
+    _seq_writes++;
+    return t;
+  }
+
+  if (_cfg.host_managed) {
+    // read-modify-write of the band behind the write up to the write pointer
+    uint64 tail = off + size < wp ? wp - (off + size) : 0;
+    t = ts;
+    if (tail > 0) t = HDD::read(t, address + size, tail);
+    t = HDD::write(t, address, size + tail);
+    if (off + size > wp) _wp[z] = off + size;
+    _rmw_writes++;
+    _rmw_bytes += tail;
+    return t;
+  }
+
+  // drive-managed: append to the media cache, clean if it is full
+  t = ts;
+  while ((_mc_used + size > _cfg.mc_size) && (_mc_used > 0)) {
+    SimTime start = t;
+    t = clean_zone(t, dirtiest_zone());
+    _fg_cleans++;
+    _fg_clean_time += t - start;
+  }
+
+  if (size > _cfg.mc_size) {
+    // larger than the media cache: rewrite the zone in place
+    return clean_zone(HDD::write(t, address, size), z);
+  }
+
+  // the media cache is a circular log: the zones whose data are still
+  // where the log continues are cleaned first (this resets the head if the
+  // media cache becomes empty)
+  if (_mc_head + size > _cfg.mc_size) _mc_head = 0;
+  t = clean_range(t, _mc_head, _mc_head + size);
+
+  MCExtent e = { address, size, _mc_start + _mc_head };
+  t = HDD::write(t, e.mc_address, size);
+  _mc[z].push_back(e);
+  _mc_live[_mc_head + size] = make_pair(_mc_head, z);
+  _mc_bytes[z] += size;
+  _mc_used += size;
+  _mc_head += size;
+  _mc_writes++;
+  return t;
+}
+
+SimTime SMRHDD::clean_idle(SimTime ts)
+{
+  if (_cfg.host_managed || (_mc_used == 0) ||
+      (ts < _busy_until + _clean_idle)) {
+    return ts;
+  }
+
+  // clean zones while the drive is idle; a clean in progress when the
+  // request arrives has to be completed first
+  SimTime t = _busy_until + _clean_idle;
+  while ((t < ts) && (_mc_used > 0)) {
+    t = clean_zone(t, dirtiest_zone());
+    _bg_cleans++;
+  }
+  if (t <= ts) return ts;
+
+  _fg_clean_time += t - ts;
+  return t;
+}
+
+SimTime SMRHDD::clean_zone(SimTime ts, uint32 z)
+{
+  uint64 zs = _zone_start[z];
+  uint64 wp = _wp[z];
+  SimTime t = ts;
+
+  // read the valid data of the zone and the cached updates, rewrite the zone
+  for (size_t i=0; i<_mc[z].size(); i++) {
+    wp = max(wp, _mc[z][i].address + _mc[z][i].size - zs);
+  }
+  if (wp > 0) t = HDD::read(t, zs, wp);
+  for (size_t i=0; i<_mc[z].size(); i++) {
+    t = HDD::read(t, _mc[z][i].mc_address, _mc[z][i].size);
+  }
+  if (wp > 0) t = HDD::write(t, zs, wp);
+
+  for (size_t i=0; i<_mc[z].size(); i++) {
+    _mc_live.erase(_mc[z][i].mc_address - _mc_start + _mc[z][i].size);
+  }
+  _wp[z] = wp;
+  _mc_used -= _mc_bytes[z];
+  _mc_bytes[z] = 0;
+  _mc[z].clear();
+  if (_mc_used == 0) _mc_head = 0;
+
+  _clean_time += t - ts;
+  return t;
+}
+
+SimTime SMRHDD::clean_range(SimTime ts, uint64 lo, uint64 hi)
+{
+  SimTime t = ts;
+
+  // extents do not overlap: the first one ending after lo is the only one
+  // that can reach into the range from below
+  MCIndex::iterator it;
+  while (((it = _mc_live.upper_bound(lo)) != _mc_live.end()) &&
+         (it->second.first < hi)) {
+    SimTime start = t;
+    t = clean_zone(t, it->second.second);
+    _fg_cleans++;
+    _fg_clean_time += t - start;
+  }
+  return t;
+}
+
+uint32 SMRHDD::dirtiest_zone(void) const
+{
+  return max_element(_mc_bytes.begin(), _mc_bytes.end()) - _mc_bytes.begin();
+}
+
+void SMRHDD::save(Snapshot &s) const
+{
+  HDD::save(s);
+
+  s.begin("smr");
+  s.put((uint64)_cfg.host_managed);
+  s.put(_wp);
+  s.put(_mc_head);
+  s.put(_mc_used);
+  s.put(_mc_bytes);
+  for (size_t z=0; z<_mc.size(); z++) s.put(_mc[z]);
+  s.put(_busy_until);
+
+  s.put(_seq_writes);
+  s.put(_rmw_writes);
+  s.put(_rmw_bytes);
+  s.put(_mc_writes);
+  s.put(_mc_reads);
+  s.put(_bg_cleans);
+  s.put(_fg_cleans);
+  s.put(_clean_time);
+  s.put(_fg_clean_time);
+}
+
+bool SMRHDD::restore(Snapshot &s)
+{
+  if (!HDD::restore(s) || !s.expect("smr")) return false;
+
+  size_t zones = _wp.size();
+  if ((s.get_u64() != (uint64)_cfg.host_managed)) return false;
+  s.get(&_wp);
+  _mc_head = s.get_u64();
+  _mc_used = s.get_u64();
+  s.get(&_mc_bytes);
+  if ((_wp.size() != zones) || (_mc_bytes.size() != zones)) {
+    cout << "snapshot of a different SMR zone layout" << endl;
+    return false;
+  }
+  _mc_live.clear();
+  for (size_t z=0; z<zones; z++) {
+    s.get(&_mc[z]);
+    for (size_t i=0; i<_mc[z].size(); i++) {
+      const MCExtent &e = _mc[z][i];
+      uint64 lo = e.mc_address - _mc_start;
+      _mc_live[lo + e.size] = make_pair(lo, (uint32)z);
+    }
+  }
+  _busy_until = s.get_i64();
+
+  _seq_writes    = s.get_u64();
+  _rmw_writes    = s.get_u64();
+  _rmw_bytes     = s.get_u64();
+  _mc_writes     = s.get_u64();
+  _mc_reads      = s.get_u64();
+  _bg_cleans     = s.get_u64();
+  _fg_cleans     = s.get_u64();
+  _clean_time    = s.get_i64();
+  _fg_clean_time = s.get_i64();
+  return s.good();
+}
+
+void SMRHDD::print_stats(ostream &os) const
+{
+  uint32 dirty = 0;
+  for (size_t z=0; z<_mc_bytes.size(); z++) dirty += _mc_bytes[z] > 0;
+
+  os.precision(6);
+  os << "SMR: " << endl
+     << "  mode:                 "
+     << (_cfg.host_managed ? "host-managed" : "drive-managed") << endl
+     << "  zones:                " << _wp.size() << " x "
+     << _cfg.zone_tracks << " tracks" << endl
+     << "  sequential writes:    " << _seq_writes << endl;
+  if (_cfg.host_managed) {
+    os << "  read-modify-writes:   " << _rmw_writes << " ("
+       << _rmw_bytes << " bytes rewritten)" << endl;
+  } else {
+    os << "  media cache:          " << _cfg.mc_size << " bytes, "
+       << _mc_used << " used by " << dirty << " zones" << endl
+       << "  media cache writes:   " << _mc_writes << endl
+       << "  media cache reads:    " << _mc_reads << endl
+       << "  zones cleaned:        " << _bg_cleans << " background, "
+       << _fg_cleans << " foreground" << endl
+       << "  cleaning time:        " << dec << fixed
+       << sim_seconds(_clean_time) << " (requests blocked "
+       << sim_seconds(_fg_clean_time) << ")" << endl;
+  }
+  os << endl;
+}
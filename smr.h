@@ -0,0 +1,199 @@
+//------------------------------------------------------------------------------
+/// @brief shingled magnetic recording (SMR) HDDs
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_SMR_H__
+#define __CA_SMR_H__
+
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include "hdd.h"
+using namespace std;
+
+//------------------------------------------------------------------------------
+/// @brief configuration of an SMR HDD
+///
+/// A configuration is parsed from a comma-separated list of key=value pairs:
+///
+/// - mode=hm|dm             host-managed or drive-managed
+/// - zone=<tracks>          tracks (cylinders) per zone
+/// - mc=<bytes>             size of the media cache (dm), K/M/G suffixes
+/// - idle=<seconds>         idle time before background cleaning starts (dm)
+/// - wp=empty|full          initial position of the write pointers
+///
+typedef struct _smr_config {
+  bool   host_managed;              ///< host-managed (true) or drive-managed
+  uint32 zone_tracks;               ///< tracks per zone
+  uint64 mc_size;                   ///< media cache size in bytes
+  double clean_idle;                ///< idle time before cleaning starts
+  bool   full;                      ///< zones are initially full
+} SMRConfig;
+
+/// @brief initialize @a cfg with default values
+void smr_defaults(SMRConfig *cfg);
+
+/// @brief parse @a spec into @a cfg (on top of the values already in @a cfg)
+/// @retval true if @a spec was parsed successfully, false otherwise
+bool smr_parse(const char *spec, SMRConfig *cfg);
+
+
+//------------------------------------------------------------------------------
+/// @brief shingled magnetic recording (SMR) HDDs
+///
+/// SMRHDD divides the disk into zones of SMRConfig::zone_tracks consecutive
+/// tracks. Tracks of a zone overlap, so a zone can only be written
+/// sequentially at its write pointer; writing before the write pointer
+/// destroys the data behind it.
+///
+/// - host-managed: a write before the write pointer is charged a
+///   read-modify-write of the band from the end of the write up to the write
+///   pointer.
+/// - drive-managed: a write before the write pointer is appended to a
+///   persistent media cache on the outermost (conventional) tracks. Cached
+///   data is merged into its zone (read zone + cached data, rewrite zone) by
+///   a cleaner that runs when the drive has been idle for
+///   SMRConfig::clean_idle seconds, or in the foreground when the media
+///   cache is full. The media cache is a circular log; when the log reaches
+///   data that is still cached, the zones of that data are cleaned in the
+///   foreground first. Reads of data in the media cache read it from there.
+///
+/// Writes at or beyond the write pointer are sequential and advance it.
+///
+class SMRHDD : public HDD {
+  public:
+    /// @name constructor/destructor
+    /// @{
+
+    /// @brief constructor
+    SMRHDD(uint32 surfaces, uint32 tracks_per_surface,
+           uint32 sectors_innermost_track, uint32 sectors_outermost_track,
+           uint32 rpm, uint32 sector_size,
+           double seek_overhead, double seek_per_track,
+           const SMRConfig &cfg);
+
+    /// @brief destructor
+    virtual ~SMRHDD(void);
+
+    /// @}
+
+
+    /// @name access methods
+    /// @{
+
+    /// @brief read @a size bytes from @a address
+    virtual SimTime read(SimTime ts, uint64 address, uint64 size);
+
+    /// @brief write @a size bytes to @a address
+    virtual SimTime write(SimTime ts, uint64 address, uint64 size);
+
+    /// @}
+
+
+    /// @name statistics
+    /// @{
+
+    /// @brief print the SMR statistics to @a os
+    void   print_stats(ostream &os) const;
+
+    /// @}
+
+
+    /// @name snapshots
+    /// @{
+
+    /// @brief save the state of the disk to snapshot @a s
+    virtual void save(Snapshot &s) const;
+
+    /// @brief restore the state of the disk from snapshot @a s
+    virtual bool restore(Snapshot &s);
+
+    /// @}
+
+
+  protected:
+    ///@brief data of a zone held in the media cache
+    typedef struct _mc_extent {
+      uint64 address;               ///< address in the zone
+      uint64 size;                  ///< number of bytes
+      uint64 mc_address;            ///< address in the media cache
+    } MCExtent;
+
+    /// @brief end offset in the media cache -> start offset and zone
+    typedef map<uint64, pair<uint64, uint32> > MCIndex;
+
+    SMRConfig _cfg;                 ///< configuration
+    SimTime _clean_idle;            ///< idle time before cleaning starts
+    vector<uint64> _zone_start;     ///< first address of each zone (+ end)
+    vector<uint64> _wp;             ///< write pointer (offset) of each zone
+    uint64 _mc_start;               ///< first address of the media cache
+    uint64 _mc_head;                ///< next append offset in the media cache
+    uint64 _mc_used;                ///< bytes in the media cache
+    vector<uint64> _mc_bytes;       ///< bytes of each zone in the media cache
+    vector<vector<MCExtent> > _mc;  ///< media cache extents of each zone
+    MCIndex _mc_live;               ///< media cache extents by end offset
+    SimTime _busy_until;            ///< time the last access completed
+
+    // statistics
+    uint64 _seq_writes;             ///< writes at the write pointer
+    uint64 _rmw_writes;             ///< writes with read-modify-write (hm)
+    uint64 _rmw_bytes;              ///< bytes rewritten by read-modify-write
+    uint64 _mc_writes;              ///< writes into the media cache (dm)
+    uint64 _mc_reads;               ///< reads served from the media cache
+    uint64 _bg_cleans;              ///< zones cleaned in the background
+    uint64 _fg_cleans;              ///< zones cleaned in the foreground
+    SimTime _clean_time;            ///< time spent cleaning
+    SimTime _fg_clean_time;         ///< time requests waited for cleaning
+
+    /// @brief zone containing @a address
+    uint32 zone_of(uint64 address) const;
+
+    /// @brief write the part of a request that lies in zone @a z
+    SimTime write_zone(SimTime ts, uint32 z, uint64 address, uint64 size);
+
+    /// @brief clean in the background until @a ts (idle time)
+    /// @retval time when the drive is ready to serve a request arriving at
+    ///         @a ts
+    SimTime clean_idle(SimTime ts);
+
+    /// @brief merge the media cache data of zone @a z into the zone
+    SimTime clean_zone(SimTime ts, uint32 z);
+
+    /// @brief clean the zones with data in [@a lo, @a hi) of the media
+    ///        cache (offsets) in the foreground
+    SimTime clean_range(SimTime ts, uint64 lo, uint64 hi);
+
+    /// @brief zone with the most data in the media cache
+    uint32 dirtiest_zone(void) const;
+};
+
+#endif // __CA_SMR_H__
@@ -0,0 +1,142 @@
+//------------------------------------------------------------------------------
+/// @brief binary snapshots of the simulator state
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <cstdio>
+#include <cstring>
+
+#include <iostream>
+
+#include "snapshot.h"
+using namespace std;
+
+//------------------------------------------------------------------------------
+// Snapshot
+//
+Snapshot::Snapshot(void)
+  : _f(NULL), _writing(false), _ok(false)
+{
+}
+
+Snapshot::~Snapshot(void)
+{
+  if (_f != NULL) {
+    fclose(_f);
+    if (_writing) remove(_tmp.c_str());
+  }
+}
+
+bool Snapshot::create(const char *path)
+{
+  _path = path;
+  _tmp = _path + ".tmp";
+  _writing = true;
+  _f = fopen(_tmp.c_str(), "wb");
+  _ok = _f != NULL;
+  if (!_ok) {
+    cout << "cannot create snapshot " << _tmp << endl;
+    return false;
+  }
+
+  put((uint64)SNAPSHOT_MAGIC);
+  put((uint64)SNAPSHOT_VERSION);
+  return _ok;
+}
+
+bool Snapshot::open(const char *path)
+{
+  _path = path;
+  _writing = false;
+  _f = fopen(path, "rb");
+  _ok = _f != NULL;
+  if (!_ok) {
+    cout << "cannot open snapshot " << path << endl;
+    return false;
+  }
+
+  if ((get_u64() != SNAPSHOT_MAGIC) || (get_u64() != SNAPSHOT_VERSION)) {
+    cout << "invalid snapshot " << path << endl;
+    _ok = false;
+  }
+  return _ok;
+}
+
+bool Snapshot::close(void)
+{
+  if (_f == NULL) return false;
+
+  if (_writing) {
+    _ok = (fflush(_f) == 0) && _ok;
+    _ok = (fclose(_f) == 0) && _ok;
+    _f = NULL;
+    if (_ok) _ok = rename(_tmp.c_str(), _path.c_str()) == 0;
+    if (!_ok) {
+      cout << "cannot write snapshot " << _path << endl;
+      remove(_tmp.c_str());
+    }
+  } else {
+    // the whole snapshot must have been consumed
+    _ok = _ok && (fgetc(_f) == EOF);
+    fclose(_f);
+    _f = NULL;
+    if (!_ok) cout << "corrupt snapshot " << _path << endl;
+  }
+  return _ok;
+}
+
+/// the first eight characters of @a tag as a number
+static uint64 tag_value(const char *tag)
+{
+  uint64 t = 0;
+  memcpy(&t, tag, strnlen(tag, sizeof(t)));
+  return t;
+}
+
+void Snapshot::begin(const char *tag)
+{
+  put(tag_value(tag));
+}
+
+bool Snapshot::expect(const char *tag)
+{
+  if (get_u64() != tag_value(tag)) _ok = false;
+  return _ok;
+}
+
+void Snapshot::write(const void *p, size_t n)
+{
+  if (_ok && (fwrite(p, 1, n, _f) != n)) _ok = false;
+}
+
+void Snapshot::read(void *p, size_t n)
+{
+  if (_ok && (fread(p, 1, n, _f) != n)) _ok = false;
+}
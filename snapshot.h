@@ -0,0 +1,138 @@
+//------------------------------------------------------------------------------
+/// @brief binary snapshots of the simulator state
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_SNAPSHOT_H__
+#define __CA_SNAPSHOT_H__
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "disk.h"
+using namespace std;
+
+#define SNAPSHOT_MAGIC   0x50414e534c44ULL  ///< "DLSNAP"
+#define SNAPSHOT_VERSION 2                  ///< format version
+
+//------------------------------------------------------------------------------
+/// @brief binary snapshot of the simulator state
+///
+/// A Snapshot is a file of raw values in host byte order. Every stateful
+/// object writes its state with the put methods and reads it back in the
+/// same order with the get methods; doubles are stored bit-exactly so a
+/// restored simulation continues with identical results. Sections are
+/// tagged so that a mismatch between writer and reader is detected.
+///
+/// A snapshot is written to a temporary file that replaces @a path only when
+/// it is closed successfully, so a crash never leaves a partial snapshot.
+///
+class Snapshot {
+  public:
+    /// @name constructor/destructor
+    /// @{
+
+    /// @brief constructor
+    Snapshot(void);
+
+    /// @brief destructor. Discards an unfinished snapshot.
+    ~Snapshot(void);
+
+    /// @}
+
+
+    /// @name file handling
+    /// @{
+
+    /// @brief create a snapshot in @a path
+    bool   create(const char *path);
+
+    /// @brief open the snapshot in @a path for reading
+    bool   open(const char *path);
+
+    /// @brief finish the snapshot
+    /// @retval true if all values were written/read successfully
+    bool   close(void);
+
+    /// @brief true if no error has occurred
+    bool   good(void) const { return _ok; }
+
+    /// @}
+
+
+    /// @name values
+    /// @{
+
+    void   put(uint64 v) { write(&v, sizeof(v)); }     ///< write @a v
+    void   put(int64 v) { write(&v, sizeof(v)); }      ///< write @a v
+    void   put(double v) { write(&v, sizeof(v)); }     ///< write @a v
+    uint64 get_u64(void) { uint64 v = 0; read(&v, sizeof(v)); return v; }
+    int64  get_i64(void) { int64 v = 0; read(&v, sizeof(v)); return v; }
+    double get_double(void) { double v = 0; read(&v, sizeof(v)); return v; }
+
+    /// @brief write the elements of @a v
+    template<class T> void put(const vector<T> &v)
+    {
+      put((uint64)v.size());
+      if (!v.empty()) write(&v[0], v.size() * sizeof(T));
+    }
+
+    /// @brief read elements into @a v
+    template<class T> void get(vector<T> *v)
+    {
+      uint64 n = get_u64();
+      if (!_ok || (n > ((uint64)1 << 40) / sizeof(T))) { _ok = false; return; }
+      v->resize(n);
+      if (n > 0) read(&(*v)[0], n * sizeof(T));
+    }
+
+    /// @brief write section tag @a tag
+    void   begin(const char *tag);
+
+    /// @brief check section tag @a tag
+    /// @retval true if the next section is @a tag
+    bool   expect(const char *tag);
+
+    /// @}
+
+
+  protected:
+    FILE  *_f;                      ///< snapshot file
+    bool   _writing;                ///< snapshot is being written
+    bool   _ok;                     ///< no error so far
+    string _path;                   ///< final path of the snapshot
+    string _tmp;                    ///< temporary file while writing
+
+    void   write(const void *p, size_t n);
+    void   read(void *p, size_t n);
+};
+
+#endif // __CA_SNAPSHOT_H__
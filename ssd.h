@@ -0,0 +1,87 @@
+//------------------------------------------------------------------------------
+/// @brief flash-based storage devices (SSD)
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_SSD_H__
+#define __CA_SSD_H__
+
+#include "disk.h"
+using namespace std;
+
+//------------------------------------------------------------------------------
+/// @brief flash-based storage devices (SSD)
+///
+/// The SSD class implements a simple flash device: every access costs a fixed
+/// latency plus the transfer of the data at the bandwidth of the device.
+/// Accesses do not depend on the address.
+///
+class SSD : public Disk {
+  public:
+    /// @name constructor/destructor
+    /// @{
+
+    /// @brief constructor
+    /// @param read_latency latency of a read (seconds)
+    /// @param write_latency latency of a write (seconds)
+    /// @param bandwidth transfer rate (bytes per second)
+    SSD(double read_latency, double write_latency, double bandwidth);
+
+    /// @brief destructor
+    virtual ~SSD(void);
+
+    /// @}
+
+
+    /// @name access methods
+    /// @{
+
+    /// @brief read @a size bytes from @a address
+    virtual SimTime read(SimTime ts, uint64 address, uint64 size);
+
+    /// @brief write @a size bytes to @a address
+    virtual SimTime write(SimTime ts, uint64 address, uint64 size);
+
+    /// @}
+
+
+  protected:
+    SimTime _read_latency;          ///< latency of a read
+    SimTime _write_latency;         ///< latency of a write
+    int64  _fs;                     ///< transfer time per byte (fs)
+
+    /// @brief transfer time of @a size bytes
+    SimTime transfer(uint64 size) const
+    {
+      return (SimTime)((size * _fs + 500000) / 1000000);
+    }
+};
+
+#endif // __CA_SSD_H__
@@ -0,0 +1,180 @@
+//------------------------------------------------------------------------------
+/// @brief latency statistics
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include <iostream>
+#include <iomanip>
+
+#include "stats.h"
+#include "snapshot.h"
+using namespace std;
+
+//------------------------------------------------------------------------------
+// LatencyStats
+//
+LatencyStats::LatencyStats(void)
+{
+  reset();
+}
+
+void LatencyStats::add(double v)
+{
+  if (_count == 0 || v < _min) _min = v;
+  if (_count == 0 || v > _max) _max = v;
+  _count++;
+  _sum += v;
+  _bucket[bucket_of(v)]++;
+}
+
+void LatencyStats::merge(const LatencyStats &other)
+{
+  if (other._count == 0) return;
+
+  if (_count == 0 || other._min < _min) _min = other._min;
+  if (_count == 0 || other._max > _max) _max = other._max;
+  _count += other._count;
+  _sum += other._sum;
+  for (uint32 b=0; b<STATS_BUCKETS; b++) _bucket[b] += other._bucket[b];
+}
+
+void LatencyStats::reset(void)
+{
+  _count = 0;
+  _sum = _min = _max = 0.0;
+  memset(_bucket, 0, sizeof(_bucket));
+}
+
+void LatencyStats::save(Snapshot &s) const
+{
+  s.begin("stats");
+  s.put(_count);
+  s.put(_sum);
+  s.put(_min);
+  s.put(_max);
+
+  // non-empty buckets only
+  vector<uint64> nz;
+  for (uint32 b=0; b<STATS_BUCKETS; b++) {
+    if (_bucket[b] > 0) {
+      nz.push_back(b);
+      nz.push_back(_bucket[b]);
+    }
+  }
+  s.put(nz);
+}
+
+bool LatencyStats::restore(Snapshot &s)
+{
+  reset();
+  if (!s.expect("stats")) return false;
+  _count = s.get_u64();
+  _sum   = s.get_double();
+  _min   = s.get_double();
+  _max   = s.get_double();
+
+  vector<uint64> nz;
+  s.get(&nz);
+  for (size_t i=0; i+1<nz.size(); i+=2) {
+    if (nz[i] >= STATS_BUCKETS) return false;
+    _bucket[nz[i]] = nz[i+1];
+  }
+  return s.good();
+}
+
+double LatencyStats::mean(void) const
+{
+  return _count > 0 ? _sum / _count : 0.0;
+}
+
+double LatencyStats::percentile(double p) const
+{
+  if (_count == 0) return 0.0;
+
+  // rank of the requested sample (1-based)
+  uint64 rank = (uint64)ceil(p / 100.0 * _count);
+  if (rank < 1) rank = 1;
+  if (rank >= _count) return _max;
+
+  uint64 seen = 0;
+  for (uint32 b=0; b<STATS_BUCKETS; b++) {
+    seen += _bucket[b];
+    if (seen >= rank) {
+      double v = bucket_value(b);
+      if (v < _min) v = _min;
+      if (v > _max) v = _max;
+      return v;
+    }
+  }
+  return _max;
+}
+
+void LatencyStats::print(ostream &os, const char *name) const
+{
+  os.precision(6);
+  os << "  " << left << setw(12) << name << right << dec << fixed
+     << " n=" << _count
+     << " mean=" << mean()
+     << " min=" << min()
+     << " p50=" << percentile(50.0)
+     << " p90=" << percentile(90.0)
+     << " p99=" << percentile(99.0)
+     << " p99.9=" << percentile(99.9)
+     << " max=" << max()
+     << endl;
+}
+
+uint32 LatencyStats::bucket_of(double v)
+{
+  if (!(v > 0.0)) return 0;
+
+  // v = m * 2^e with 0.5 <= m < 1
+  int e;
+  double m = frexp(v, &e);
+  if (e <= STATS_MIN_EXP) return 0;
+  if (e > STATS_MAX_EXP) return STATS_BUCKETS - 1;
+
+  uint32 sub = (uint32)((m - 0.5) * 2.0 * STATS_SUB_BUCKETS);
+  if (sub >= STATS_SUB_BUCKETS) sub = STATS_SUB_BUCKETS - 1;
+  return (e - 1 - STATS_MIN_EXP) * STATS_SUB_BUCKETS + sub;
+}
+
+double LatencyStats::bucket_value(uint32 b)
+{
+  int    e   = b / STATS_SUB_BUCKETS + STATS_MIN_EXP;
+  uint32 sub = b % STATS_SUB_BUCKETS;
+  double lo  = ldexp(1.0 + (double)sub / STATS_SUB_BUCKETS, e);
+  double hi  = ldexp(1.0 + (double)(sub + 1) / STATS_SUB_BUCKETS, e);
+  return sqrt(lo * hi);
+}
@@ -0,0 +1,121 @@
+//------------------------------------------------------------------------------
+/// @brief latency statistics
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_STATS_H__
+#define __CA_STATS_H__
+
+#include <iostream>
+
+#include "disk.h"
+using namespace std;
+
+//------------------------------------------------------------------------------
+/// @brief latency statistics with a fixed-size histogram
+///
+/// LatencyStats accumulates count, sum, minimum and maximum of a series of
+/// latencies (in seconds) and sorts each sample into a log-linear histogram
+/// so that percentiles can be estimated without storing the samples. Each
+/// power of two is split into STATS_SUB_BUCKETS buckets, i.e., percentiles are
+/// accurate to about 3%. Memory use is independent of the number of samples.
+///
+#define STATS_MIN_EXP     -30       ///< smallest bucket starts at 2^-30 s (1ns)
+#define STATS_MAX_EXP      14       ///< largest bucket ends at 2^14 s
+#define STATS_SUB_BUCKETS  32       ///< buckets per power of two
+#define STATS_BUCKETS     ((STATS_MAX_EXP - STATS_MIN_EXP) * STATS_SUB_BUCKETS)
+
+class LatencyStats {
+  public:
+    /// @name constructor/destructor
+    /// @{
+
+    /// @brief constructor
+    LatencyStats(void);
+
+    /// @}
+
+
+    /// @name sampling
+    /// @{
+
+    /// @brief add sample @a v
+    void   add(double v);
+
+    /// @brief add all samples of @a other
+    void   merge(const LatencyStats &other);
+
+    /// @brief remove all samples
+    void   reset(void);
+
+    /// @brief save the samples to snapshot @a s
+    void   save(Snapshot &s) const;
+
+    /// @brief restore the samples from snapshot @a s
+    bool   restore(Snapshot &s);
+
+    /// @}
+
+
+    /// @name results
+    /// @{
+
+    uint64 count(void) const { return _count; }   ///< number of samples
+    double sum(void) const { return _sum; }       ///< sum of samples
+    double min(void) const { return _count > 0 ? _min : 0.0; } ///< minimum
+    double max(void) const { return _count > 0 ? _max : 0.0; } ///< maximum
+
+    /// @brief mean of all samples
+    double mean(void) const;
+
+    /// @brief estimated @a p-th percentile (0 <= @a p <= 100)
+    double percentile(double p) const;
+
+    /// @brief print a one-line summary labelled @a name to @a os
+    void   print(ostream &os, const char *name) const;
+
+    /// @}
+
+
+  protected:
+    uint64 _count;                  ///< number of samples
+    double _sum;                    ///< sum of samples
+    double _min;                    ///< smallest sample
+    double _max;                    ///< largest sample
+    uint64 _bucket[STATS_BUCKETS];  ///< histogram
+
+    /// @brief histogram bucket of value @a v
+    static uint32 bucket_of(double v);
+
+    /// @brief (geometric) center value of bucket @a b
+    static double bucket_value(uint32 b);
+};
+
+#endif // __CA_STATS_H__
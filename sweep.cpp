@@ -0,0 +1,434 @@
+//------------------------------------------------------------------------------
+/// @brief single-pass replay of many HDD configurations
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <iostream>
+#include <iomanip>
+#include <thread>
+
+#include "sweep.h"
+#include "hdd.h"
+#include "options.h"
+using namespace std;
+
+//------------------------------------------------------------------------------
+// SweepConfig
+//
+void sweep_defaults(SweepConfig *cfg)
+{
+  cfg->surfaces.clear();
+  cfg->tracks.clear();
+  cfg->inner.clear();
+  cfg->outer.clear();
+  cfg->rpm.clear();
+  cfg->sector.clear();
+  cfg->overhead.clear();
+  cfg->pertrack.clear();
+  cfg->threads = 0;
+}
+
+/// parse a colon-separated list of positive integers
+static bool parse_u32_list(const char *val, vector<uint32> *list)
+{
+  list->clear();
+  do {
+    char *end;
+    unsigned long v = strtoul(val, &end, 10);
+    if ((end == val) || (v == 0) || (v > 0xffffffffUL) ||
+        ((*end != ':') && (*end != '\0'))) return false;
+    list->push_back((uint32)v);
+    val = *end == ':' ? end + 1 : end;
+  } while (*val != '\0');
+  return true;
+}
+
+/// parse a colon-separated list of non-negative numbers
+static bool parse_double_list(const char *val, vector<double> *list)
+{
+  list->clear();
+  do {
+    char *end;
+    double v = strtod(val, &end);
+    if ((end == val) || (v < 0.0) || ((*end != ':') && (*end != '\0'))) {
+      return false;
+    }
+    list->push_back(v);
+    val = *end == ':' ? end + 1 : end;
+  } while (*val != '\0');
+  return true;
+}
+
+static bool parse_option(const char *key, const char *val, void *ctx)
+{
+  SweepConfig *cfg = (SweepConfig*)ctx;
+
+  if (strcmp(key, "surfaces") == 0) return parse_u32_list(val, &cfg->surfaces);
+  if (strcmp(key, "tracks") == 0) return parse_u32_list(val, &cfg->tracks);
+  if (strcmp(key, "inner") == 0) return parse_u32_list(val, &cfg->inner);
+  if (strcmp(key, "outer") == 0) return parse_u32_list(val, &cfg->outer);
+  if (strcmp(key, "rpm") == 0) return parse_u32_list(val, &cfg->rpm);
+  if (strcmp(key, "sector") == 0) return parse_u32_list(val, &cfg->sector);
+  if (strcmp(key, "overhead") == 0) {
+    return parse_double_list(val, &cfg->overhead);
+  }
+  if (strcmp(key, "pertrack") == 0) {
+    return parse_double_list(val, &cfg->pertrack);
+  }
+  if (strcmp(key, "threads") == 0) {
+    char *end;
+    cfg->threads = (uint32)strtoul(val, &end, 10);
+    return (end != val) && (*end == '\0');
+  }
+
+  return false;
+}
+
+bool sweep_parse(const char *spec, SweepConfig *cfg)
+{
+  return parse_options(spec, parse_option, cfg, "sweep");
+}
+
+bool sweep_expand(const SweepConfig &cfg, const dl_geometry &base,
+                  vector<dl_geometry> *geo)
+{
+  // a parameter without values keeps the one of the base geometry
+  vector<uint32> surfaces = cfg.surfaces, tracks = cfg.tracks,
+                 inner = cfg.inner, outer = cfg.outer, rpm = cfg.rpm,
+                 sector = cfg.sector;
+  vector<double> overhead = cfg.overhead, pertrack = cfg.pertrack;
+  if (surfaces.empty()) surfaces.push_back(base.surfaces);
+  if (tracks.empty())   tracks.push_back(base.tracks_per_surface);
+  if (inner.empty())    inner.push_back(base.sectors_innermost_track);
+  if (outer.empty())    outer.push_back(base.sectors_outermost_track);
+  if (rpm.empty())      rpm.push_back(base.rpm);
+  if (sector.empty())   sector.push_back(base.sector_size);
+  if (overhead.empty()) overhead.push_back(base.seek_overhead);
+  if (pertrack.empty()) pertrack.push_back(base.seek_per_track);
+
+  geo->clear();
+  dl_geometry g;
+  for (size_t a=0; a<surfaces.size(); a++)
+  for (size_t b=0; b<tracks.size(); b++)
+  for (size_t c=0; c<inner.size(); c++)
+  for (size_t d=0; d<outer.size(); d++)
+  for (size_t e=0; e<rpm.size(); e++)
+  for (size_t f=0; f<sector.size(); f++)
+  for (size_t h=0; h<overhead.size(); h++)
+  for (size_t i=0; i<pertrack.size(); i++) {
+    g.surfaces                = surfaces[a];
+    g.tracks_per_surface      = tracks[b];
+    g.sectors_innermost_track = inner[c];
+    g.sectors_outermost_track = outer[d];
+    g.rpm                     = rpm[e];
+    g.sector_size             = sector[f];
+    g.seek_overhead           = overhead[h];
+    g.seek_per_track          = pertrack[i];
+    if ((g.tracks_per_surface < 2) ||
+        (g.sectors_outermost_track < g.sectors_innermost_track)) {
+      cout << "invalid geometry in the sweep: " << g.tracks_per_surface
+           << " tracks, " << g.sectors_innermost_track << " to "
+           << g.sectors_outermost_track << " sectors per track" << endl;
+      return false;
+    }
+    // limits of the vectorized start and seek loops (see HDDSweep)
+    if ((g.sector_size & (g.sector_size - 1)) != 0) {
+      cout << "the sweep requires power-of-two sector sizes, not "
+           << g.sector_size << endl;
+      return false;
+    }
+    if (g.tracks_per_surface > SWEEP_MAX_TRACKS) {
+      cout << "the sweep supports at most " << SWEEP_MAX_TRACKS
+           << " tracks per surface, not " << g.tracks_per_surface << endl;
+      return false;
+    }
+    if (g.seek_per_track >= SWEEP_MAX_SEEK) {
+      cout << "the sweep requires a seek time per track below "
+           << SWEEP_MAX_SEEK << " s, not " << g.seek_per_track << endl;
+      return false;
+    }
+    geo->push_back(g);
+  }
+  return true;
+}
+
+
+//------------------------------------------------------------------------------
+// HDDSweep
+//
+// The loops over the configurations that do not look up tables are kept in
+// separate functions on plain arrays so that the compiler vectorizes them
+// (sweep.o is built with -O3, see the Makefile). On x86, they are compiled
+// for AVX2 and for the baseline ISA, and the loader picks the clone that the
+// CPU supports; the 64-bit compares and variable shifts need AVX2.
+//
+// The seek time of HDD is base + (diff * ps + 500) / 1000 for a distance of
+// diff tracks and ps picoseconds per track. A 64-bit division does not
+// vectorize, so with ps = 1000 * ns + rem it is computed as
+//
+//   base + diff * ns + (diff * rem + 500) / 1000
+//
+// with 32-bit operands: diff * rem + 500 fits into 32 bits for at most
+// SWEEP_MAX_TRACKS tracks, and ns does for a seek time below SWEEP_MAX_SEEK.
+//
+#if defined(__x86_64__) && defined(__GNUC__)
+#define SWEEP_CLONES __attribute__((target_clones("avx2", "default")))
+#else
+#define SWEEP_CLONES
+#endif
+
+/// start time and number of sectors of a request arriving at @a ts with
+/// @a size bytes on @a n configurations
+SWEEP_CLONES
+static void sweep_start(size_t n, SimTime ts, uint64 size,
+                        const SimTime *__restrict busy,
+                        const uint64 *__restrict shift,
+                        const uint64 *__restrict mask,
+                        SimTime *__restrict start, uint64 *__restrict sectors)
+{
+  for (size_t j=0; j<n; j++) {
+    start[j] = ts > busy[j] ? ts : busy[j];
+    sectors[j] = (size + mask[j]) >> shift[j];
+  }
+}
+
+/// time to seek from @a head to @a track on @a n configurations
+SWEEP_CLONES
+static void sweep_seek(size_t n, const uint32 *__restrict track,
+                       const uint32 *__restrict head,
+                       const SimTime *__restrict base,
+                       const uint32 *__restrict ns,
+                       const uint32 *__restrict rem, SimTime *__restrict seek)
+{
+  for (size_t j=0; j<n; j++) {
+    uint32 diff = track[j] > head[j] ? track[j] - head[j] : head[j] - track[j];
+    SimTime t = base[j] + (SimTime)((uint64)diff * ns[j]) +
+                (diff * rem[j] + 500) / 1000;
+    seek[j] = diff != 0 ? t : 0;
+  }
+}
+
+HDDSweep::HDDSweep(const vector<dl_geometry> &geo, uint32 threads)
+  : _geo(geo), _threads(threads),
+    _reads(0), _writes(0), _bytes(0), _first(0)
+{
+  size_t K = geo.size();
+
+  if (_threads == 0) _threads = thread::hardware_concurrency();
+  if (_threads == 0) _threads = 1;
+  if (_threads > K) _threads = K;
+
+  // the decode tables point into the per-configuration vectors: size the
+  // outer vectors first so that they do not move
+  _sectors.resize(K);
+  _start.resize(K);
+  _bucket.resize(K);
+  _table.resize(K);
+  for (size_t k=0; k<K; k++) {
+    const dl_geometry &g = geo[k];
+    uint32 T = g.tracks_per_surface;
+    _sectors[k].resize(T);
+    for (uint32 t=0; t<T; t++) {
+      // as HDD::num_of_sector()
+      uint64 val = (uint64)g.sectors_innermost_track * (T - 1 - t) +
+                   (uint64)g.sectors_outermost_track * t;
+      _sectors[k][t] = (uint32)(val / (T - 1));
+    }
+    decode_init(&_table[k], _sectors[k], g.surfaces, g.sector_size,
+                &_start[k], &_bucket[k]);
+
+    _ssize.push_back(g.sector_size);
+    uint64 shift = 0;
+    while ((1ULL << shift) < g.sector_size) shift++;
+    _sshift.push_back(shift);
+    _smask.push_back(g.sector_size - 1);
+    _rpm.push_back(g.rpm);
+    _seek_base.push_back(sim_time(g.seek_overhead));
+    int64 ps = (int64)(g.seek_per_track * 1e12 + 0.5);
+    _seek_ps.push_back(ps);
+    _seek_ns.push_back((uint32)(ps / 1000));
+    _seek_rem.push_back((uint32)(ps % 1000));
+    _half_turn.push_back((30 * SIM_SECOND + g.rpm / 2) / g.rpm);
+  }
+
+  _head.assign(K, 0);
+  _busy.assign(K, 0);
+  _last.assign(K, 0);
+  _invalid.assign(K, 0);
+  _service.resize(K);
+  _response.resize(K);
+}
+
+void HDDSweep::advance(size_t lo, size_t hi, const vector<Request> *chunk)
+{
+  size_t n = hi - lo;
+  vector<SimTime> start(n), seek(n);
+  vector<uint64>  sectors(n);
+  vector<uint32>  track(n), avail(n);
+
+  for (size_t r=0; r<chunk->size(); r++) {
+    const Request &req = (*chunk)[r];
+    const SimTime ts = req.ts;
+    const uint64 size = req.size, address = req.address;
+
+    // start time and number of sectors
+    sweep_start(n, ts, size, &_busy[lo], &_sshift[lo], &_smask[lo],
+                &start[0], &sectors[0]);
+
+    // track of the first sector (0 sectors available: invalid address)
+    for (size_t j=0; j<n; j++) {
+      HDD_Position pos;
+      decode_address(&_table[lo + j], address, &pos);
+      track[j] = pos.track;
+      avail[j] = pos.max_access;
+    }
+
+    // seek to the first track
+    sweep_seek(n, &track[0], &_head[lo], &_seek_base[lo], &_seek_ns[lo],
+               &_seek_rem[lo], &seek[0]);
+
+    // rotation and transfer, and the following tracks of long requests
+    for (size_t j=0; j<n; j++) {
+      size_t k = lo + j;
+      SimTime delay = 0;
+      uint64 left = sectors[j];
+
+      if ((left > 0) && (avail[j] == 0)) _invalid[k]++;
+      if ((left > 0) && (avail[j] > 0)) {
+        uint64 next = address;
+        uint32 t = track[j];
+        uint64 m = left < avail[j] ? left : avail[j];
+        int64 turn = _rpm[k] * _sectors[k][t];
+
+        delay = seek[j] + _half_turn[k] +
+                (60 * SIM_SECOND * m + turn / 2) / turn;
+        _head[k] = t;
+        left -= m;
+        next += m * _ssize[k];
+
+        while (left > 0) {
+          HDD_Position pos;
+          if (!decode_address(&_table[k], next, &pos)) {
+            _invalid[k]++;
+            break;
+          }
+          int64 diff = (int64)pos.track - (int64)_head[k];
+          diff = diff < 0 ? -diff : diff;
+          if (diff > 0) {
+            delay += _seek_base[k] + (diff * _seek_ps[k] + 500) / 1000;
+          }
+          _head[k] = pos.track;
+
+          m = left < pos.max_access ? left : pos.max_access;
+          turn = _rpm[k] * _sectors[k][pos.track];
+          delay += _half_turn[k] + (60 * SIM_SECOND * m + turn / 2) / turn;
+          left -= m;
+          next += m * _ssize[k];
+        }
+      }
+
+      SimTime end = start[j] + delay;
+      _busy[k] = end;
+      if (end > _last[k]) _last[k] = end;
+      _service[k].add(sim_seconds(delay));
+      _response[k].add(sim_seconds(end - ts));
+    }
+  }
+}
+
+void HDDSweep::run(Workload *wl)
+{
+  size_t K = _geo.size();
+  vector<Request> chunk;
+  chunk.reserve(SWEEP_CHUNK);
+  Request req;
+  bool more = true;
+
+  while (more) {
+    chunk.clear();
+    while ((chunk.size() < SWEEP_CHUNK) && (more = wl->next(&req))) {
+      if (_reads + _writes == 0) _first = req.ts;
+      if (req.rw == 'w') _writes++;
+      else _reads++;
+      _bytes += req.size;
+      chunk.push_back(req);
+    }
+    if (chunk.empty()) break;
+
+    if (_threads <= 1) {
+      advance(0, K, &chunk);
+    } else {
+      vector<thread> pool;
+      size_t slice = (K + _threads - 1) / _threads;
+      for (size_t lo=0; lo<K; lo+=slice) {
+        size_t hi = lo + slice < K ? lo + slice : K;
+        pool.push_back(thread(&HDDSweep::advance, this, lo, hi, &chunk));
+      }
+      for (size_t i=0; i<pool.size(); i++) pool[i].join();
+    }
+  }
+}
+
+void HDDSweep::report(ostream &os) const
+{
+  uint64 requests = _reads + _writes;
+
+  os << "parameter sweep (" << _geo.size() << " configurations, " << requests
+     << " requests, " << _threads << " threads):" << endl
+     << "  surf  tracks  inner  outer    rpm  sect  overhead  pertrack"
+     << "       iops     MB/s   svc mean   lat mean    lat p99" << endl;
+
+  for (size_t k=0; k<_geo.size(); k++) {
+    const dl_geometry &g = _geo[k];
+    double elapsed = sim_seconds(_last[k] - _first);
+    double iops = elapsed > 0.0 ? requests / elapsed : 0.0;
+    double mbs = elapsed > 0.0 ? _bytes / elapsed / 1e6 : 0.0;
+
+    os << dec << fixed
+       << setw(6) << g.surfaces << setw(8) << g.tracks_per_surface
+       << setw(7) << g.sectors_innermost_track
+       << setw(7) << g.sectors_outermost_track
+       << setw(7) << g.rpm << setw(6) << g.sector_size
+       << setprecision(6) << setw(10) << g.seek_overhead
+       << setw(10) << g.seek_per_track
+       << setprecision(2) << setw(11) << iops
+       << setprecision(3) << setw(9) << mbs
+       << setprecision(6) << setw(11) << _service[k].mean()
+       << setw(11) << _response[k].mean()
+       << setw(11) << _response[k].percentile(99.0);
+    if (_invalid[k] > 0) os << "  (" << _invalid[k] << " invalid)";
+    os << endl;
+  }
+  os << endl;
+}
@@ -0,0 +1,189 @@
+//------------------------------------------------------------------------------
+/// @brief single-pass replay of many HDD configurations
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_SWEEP_H__
+#define __CA_SWEEP_H__
+
+#include <iostream>
+#include <vector>
+
+#include "disk.h"
+#include "decode.h"
+#include "disklab.h"
+#include "stats.h"
+#include "workload.h"
+using namespace std;
+
+
+//------------------------------------------------------------------------------
+/// @brief configuration of a parameter sweep
+///
+/// A configuration is parsed from a comma-separated list of key=value pairs.
+/// Each key takes one or more values separated by colons; the sweep covers
+/// all combinations. Parameters that are not given keep the value of the
+/// HDD read from stdin.
+///
+/// - surfaces=<n>[:<n>...]          number of surfaces
+/// - tracks=<n>[:<n>...]            tracks per surface
+/// - inner=<n>[:<n>...]             sectors on the innermost track
+/// - outer=<n>[:<n>...]             sectors on the outermost track
+/// - rpm=<n>[:<n>...]               rotations per minute
+/// - sector=<bytes>[:<bytes>...]    sector size
+/// - overhead=<s>[:<s>...]          seek overhead
+/// - pertrack=<s>[:<s>...]          seek time per track
+/// - threads=<n>                    worker threads (0: one per CPU)
+///
+typedef struct _sweep_config {
+  vector<uint32> surfaces;          ///< number of surfaces
+  vector<uint32> tracks;            ///< tracks per surface
+  vector<uint32> inner;             ///< sectors on the innermost track
+  vector<uint32> outer;             ///< sectors on the outermost track
+  vector<uint32> rpm;               ///< rotations per minute
+  vector<uint32> sector;            ///< sector sizes
+  vector<double> overhead;          ///< seek overheads
+  vector<double> pertrack;          ///< seek times per track
+  uint32 threads;                   ///< worker threads
+} SweepConfig;
+
+/// @brief initialize @a cfg with default values
+void sweep_defaults(SweepConfig *cfg);
+
+/// @brief parse @a spec into @a cfg (on top of the values already in @a cfg)
+/// @retval true if @a spec was parsed successfully, false otherwise
+bool sweep_parse(const char *spec, SweepConfig *cfg);
+
+/// @brief all combinations of the values of @a cfg, with the parameters of
+///        @a base where @a cfg has none
+/// @retval true if all geometries are valid, false otherwise
+bool sweep_expand(const SweepConfig &cfg, const dl_geometry &base,
+                  vector<dl_geometry> *geo);
+
+
+//------------------------------------------------------------------------------
+/// @brief open-loop FIFO replay of one trace on many HDDs in one pass
+///
+/// HDDSweep serves each request on K HDD configurations with the same
+/// timing as HDD and Replay (the HDD starts a request when it arrives or
+/// when the previous one completes). The state of the configurations is
+/// kept as structure of arrays: head positions, busy times, and the
+/// constants derived from the sector size, rpm and seek parameters are
+/// arrays indexed by configuration, and each configuration has its own
+/// decode and sector tables. A request is advanced on all configurations by
+/// a few loops over these arrays. The start time, sector count and seek time
+/// loops look up no tables; they are written without 64-bit divisions and
+/// vectorized by the compiler (AVX2 where available). Decoding, rotation and
+/// transfer, and the following tracks of long requests are scalar loops.
+/// The vectorized loops require power-of-two sector sizes, at most
+/// SWEEP_MAX_TRACKS tracks per surface, and a seek time per track below
+/// SWEEP_MAX_SEEK seconds.
+///
+/// The trace is read in chunks of SWEEP_CHUNK requests. The configurations
+/// are split into one slice per thread, and each thread advances its slice
+/// through the whole chunk, so the trace is read and decoded once for all
+/// configurations, and the results do not depend on the number of threads.
+///
+#define SWEEP_CHUNK 65536           ///< requests per chunk
+#define SWEEP_MAX_TRACKS 4000000    ///< tracks per surface
+#define SWEEP_MAX_SEEK 4.0          ///< seek time per track (s)
+
+class HDDSweep {
+  public:
+    /// @name constructor/destructor
+    /// @{
+
+    /// @brief constructor
+    /// @param geo geometries of the configurations
+    /// @param threads worker threads (0: one per CPU)
+    HDDSweep(const vector<dl_geometry> &geo, uint32 threads);
+
+    /// @}
+
+
+    /// @name replay
+    /// @{
+
+    /// @brief replay all requests of @a wl
+    void   run(Workload *wl);
+
+    /// @}
+
+
+    /// @name statistics
+    /// @{
+
+    /// @brief number of configurations
+    size_t configs(void) const { return _geo.size(); }
+
+    /// @brief print the results of all configurations to @a os
+    void   report(ostream &os) const;
+
+    /// @}
+
+
+  protected:
+    vector<dl_geometry> _geo;       ///< geometries
+    uint32 _threads;                ///< worker threads
+
+    // per-configuration constants
+    vector<vector<uint32> > _sectors; ///< sectors per track on one surface
+    vector<vector<uint64> > _start; ///< first sector of each track
+    vector<vector<uint32> > _bucket;///< decode index
+    vector<DecodeTable> _table;     ///< decode tables
+    vector<uint32>  _ssize;         ///< sector size
+    vector<uint64>  _sshift;        ///< log2 of the sector size
+    vector<uint64>  _smask;         ///< sector size - 1
+    vector<int64>   _rpm;           ///< rotations per minute
+    vector<SimTime> _seek_base;     ///< seek overhead
+    vector<int64>   _seek_ps;       ///< seek time per track in picoseconds
+    vector<uint32>  _seek_ns;       ///< _seek_ps / 1000
+    vector<uint32>  _seek_rem;      ///< _seek_ps % 1000
+    vector<SimTime> _half_turn;     ///< average rotational latency
+
+    // per-configuration state
+    vector<uint32>  _head;          ///< head position (track)
+    vector<SimTime> _busy;          ///< completion of the last request
+    vector<SimTime> _last;          ///< latest completion
+    vector<uint64>  _invalid;       ///< requests beyond the capacity
+    vector<LatencyStats> _service;  ///< service times
+    vector<LatencyStats> _response; ///< response times
+
+    // trace statistics (the same for all configurations)
+    uint64  _reads;                 ///< number of reads
+    uint64  _writes;                ///< number of writes
+    uint64  _bytes;                 ///< number of bytes
+    SimTime _first;                 ///< first arrival
+
+    /// @brief advance configurations [@a lo, @a hi) through @a chunk
+    void   advance(size_t lo, size_t hi, const vector<Request> *chunk);
+};
+
+#endif // __CA_SWEEP_H__
@@ -0,0 +1,358 @@
+//------------------------------------------------------------------------------
+/// @brief multi-tenant replay with fair-share scheduling
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+
+#include "tenant.h"
+#include "compress.h"
+#include "options.h"
+#include "tracing.h"
+using namespace std;
+
+//------------------------------------------------------------------------------
+// TenantConfig
+//
+void tenant_defaults(TenantConfig *cfg)
+{
+  cfg->tenants.clear();
+  cfg->sched  = FAIR_WFQ;
+  cfg->budget = 1ULL << 20;
+  cfg->align  = false;
+}
+
+static bool parse_option(const char *key, const char *val, void *ctx)
+{
+  TenantConfig *cfg = (TenantConfig*)ctx;
+
+  if (strcmp(key, "trace") == 0) {
+    TenantSpec t;
+    const char *colon = strrchr(val, ':');
+    t.path = colon ? string(val, colon - val) : string(val);
+    t.weight = 1.0;
+    if (colon) {
+      char *end;
+      t.weight = strtod(colon + 1, &end);
+      if ((*end != '\0') || !(t.weight > 0.0)) return false;
+    }
+    if (t.path.empty()) return false;
+    cfg->tenants.push_back(t);
+    return true;
+  }
+  if (strcmp(key, "sched") == 0) {
+    if (strcmp(val, "fifo") == 0)   { cfg->sched = FAIR_FIFO; return true; }
+    if (strcmp(val, "wfq") == 0)    { cfg->sched = FAIR_WFQ; return true; }
+    if (strcmp(val, "budget") == 0) { cfg->sched = FAIR_BUDGET; return true; }
+    return false;
+  }
+  if (strcmp(key, "budget") == 0) {
+    return parse_size(val, &cfg->budget) && (cfg->budget > 0);
+  }
+  if (strcmp(key, "align") == 0) {
+    cfg->align = strcmp(val, "1") == 0;
+    return cfg->align || (strcmp(val, "0") == 0);
+  }
+
+  return false;
+}
+
+bool tenant_parse(const char *spec, TenantConfig *cfg)
+{
+  if (!parse_options(spec, parse_option, cfg, "tenant")) return false;
+
+  if (cfg->tenants.empty()) {
+    cout << "no tenant traces given" << endl;
+    return false;
+  }
+  return true;
+}
+
+
+//------------------------------------------------------------------------------
+// TenantReplay
+//
+TenantReplay::TenantReplay(Disk *disk, const TenantConfig &cfg)
+  : _cfg(cfg), _disk(disk), _vtime(0.0), _active(0), _left(0),
+    _first(0), _last(0), _trace_device(TRACE_DEVICE())
+{
+}
+
+TenantReplay::~TenantReplay(void)
+{
+  for (size_t t=0; t<_tenant.size(); t++) {
+    delete _tenant[t]->trace;
+    delete _tenant[t];
+  }
+}
+
+bool TenantReplay::load(void)
+{
+  for (size_t i=0; i<_cfg.tenants.size(); i++) {
+    const TenantSpec &spec = _cfg.tenants[i];
+
+    string data;
+    if (!read_file(spec.path, &data)) {
+      cout << "cannot read trace '" << spec.path << "'" << endl;
+      return false;
+    }
+
+    // skip the HDD parameters on the first line of a trace file
+    istringstream is(data);
+    string line;
+    getline(is, line);
+    istringstream fields(line);
+    string f;
+    int nf = 0;
+    while (fields >> f) nf++;
+    if (nf != 9) is.seekg(0);
+
+    TraceWorkload wl(is);
+    Tenant *t = new Tenant;
+    size_t slash = spec.path.rfind('/');
+    t->name     = slash == string::npos ? spec.path : spec.path.substr(slash+1);
+    t->weight   = spec.weight;
+    t->trace    = new MemoryWorkload(&wl);
+    t->origin   = wl.origin();
+    t->finish   = 0.0;
+    t->requests = 0;
+    t->bytes    = 0;
+    t->busy     = 0;
+    _tenant.push_back(t);
+
+    if (t->trace->size() == 0) {
+      cout << "trace '" << spec.path << "' contains no requests" << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+void TenantReplay::enqueue(size_t t, const Request &req)
+{
+  Tenant *tn = _tenant[t];
+
+  // start tag: the tenant's virtual finish time or now, whichever is later
+  double start = tn->finish > _vtime ? tn->finish : _vtime;
+  tn->finish = start + req.size / tn->weight;
+  tn->start.push_back(start);
+  tn->queue.push_back(req);
+}
+
+size_t TenantReplay::pick(void)
+{
+  size_t n = _tenant.size(), best = n;
+
+  switch (_cfg.sched) {
+    case FAIR_FIFO:
+      for (size_t t=0; t<n; t++) {
+        if (_tenant[t]->queue.empty()) continue;
+        if ((best == n) ||
+            (_tenant[t]->queue.front().ts < _tenant[best]->queue.front().ts)) {
+          best = t;
+        }
+      }
+      break;
+
+    case FAIR_WFQ:
+      for (size_t t=0; t<n; t++) {
+        if (_tenant[t]->queue.empty()) continue;
+        if ((best == n) ||
+            (_tenant[t]->start.front() < _tenant[best]->start.front())) {
+          best = t;
+        }
+      }
+      break;
+
+    case FAIR_BUDGET:
+      // keep serving the active tenant while it has budget and requests
+      if ((_left > 0) && !_tenant[_active]->queue.empty()) return _active;
+      for (size_t i=1; i<=n; i++) {
+        size_t t = (_active + i) % n;
+        if (!_tenant[t]->queue.empty()) {
+          _active = t;
+          _left = (uint64)(_cfg.budget * _tenant[t]->weight);
+          if (_left == 0) _left = 1;
+          return t;
+        }
+      }
+      break;
+  }
+
+  return best;
+}
+
+void TenantReplay::run(void)
+{
+  size_t n = _tenant.size();
+  vector<Request> next(n);
+  vector<bool>    more(n);
+  vector<SimTime> shift(n, 0);
+
+  // the request times of each trace are relative to its own origin: move
+  // them to the earliest origin, or to 0 with align
+  int64 base = _tenant[0]->origin;
+  for (size_t t=1; t<n; t++) {
+    if (_tenant[t]->origin < base) base = _tenant[t]->origin;
+  }
+  for (size_t t=0; t<n; t++) {
+    _tenant[t]->trace->rewind();
+    more[t] = _tenant[t]->trace->next(&next[t]);
+    shift[t] = (base - _tenant[t]->origin) * SIM_SECOND;
+    if (_cfg.align && more[t]) shift[t] = next[t].ts;
+    next[t].ts -= shift[t];
+  }
+
+  bool    started = false;
+  SimTime now = 0;
+  _active = n - 1;
+  _left = 0;
+
+  while (true) {
+    // earliest request not yet queued
+    size_t first = n;
+    for (size_t t=0; t<n; t++) {
+      if (more[t] && ((first == n) || (next[t].ts < next[first].ts))) {
+        first = t;
+      }
+    }
+
+    bool backlog = false;
+    for (size_t t=0; t<n; t++) backlog |= !_tenant[t]->queue.empty();
+
+    if (!backlog) {
+      if (first == n) break;
+
+      // the disk is idle: wait for the next request. The virtual time of
+      // an idle system catches up with the tenants' finish tags.
+      if (next[first].ts > now) now = next[first].ts;
+      for (size_t t=0; t<n; t++) {
+        if (_tenant[t]->finish > _vtime) _vtime = _tenant[t]->finish;
+      }
+      if (!started) {
+        _first = now;
+        started = true;
+      }
+    }
+
+    // queue the requests that have arrived by now
+    for (size_t t=0; t<n; t++) {
+      while (more[t] && (next[t].ts <= now)) {
+        enqueue(t, next[t]);
+        more[t] = _tenant[t]->trace->next(&next[t]);
+        next[t].ts -= shift[t];
+      }
+    }
+
+    // serve one request of the chosen tenant
+    size_t t = pick();
+    Tenant *tn = _tenant[t];
+    Request req = tn->queue.front();
+    _vtime = tn->start.front();
+    tn->queue.pop_front();
+    tn->start.pop_front();
+
+    TRACE_BEGIN(_trace_device,
+                ((uint64)t << 32) | tn->requests);  // tenant, request
+    SimTime end = req.rw == 'w' ? _disk->write(now, req.address, req.size)
+                                : _disk->read(now, req.address, req.size);
+    TRACE_REQUEST(req.rw, req.ts, now, end, req.address, req.size);
+    if (_cfg.sched == FAIR_BUDGET) _left -= req.size < _left ? req.size : _left;
+
+    tn->requests++;
+    tn->bytes += req.size;
+    tn->busy += end - now;
+    tn->service.add(sim_seconds(end - now));
+    tn->response.add(sim_seconds(end - req.ts));
+
+    now = end;
+    _last = end;
+  }
+}
+
+void TenantReplay::report(ostream &os, const vector<double> *alone) const
+{
+  double elapsed = sim_seconds(_last - _first);
+  double weights = 0.0, busy = 0.0;
+  for (size_t t=0; t<_tenant.size(); t++) {
+    weights += _tenant[t]->weight;
+    busy += sim_seconds(_tenant[t]->busy);
+  }
+
+  // Jain's fairness index of the disk time per unit of weight
+  double sum = 0.0, sq = 0.0;
+  for (size_t t=0; t<_tenant.size(); t++) {
+    double x = sim_seconds(_tenant[t]->busy) / _tenant[t]->weight;
+    sum += x;
+    sq += x * x;
+  }
+
+  os.precision(6);
+  os << "multi-tenant replay: " << endl
+     << "  tenants:     " << _tenant.size() << ", scheduler="
+     << (_cfg.sched == FAIR_FIFO ? "fifo" :
+         _cfg.sched == FAIR_WFQ ? "wfq" : "budget") << endl
+     << "  elapsed:     " << dec << fixed << elapsed << endl
+     << "  utilization: " << (elapsed > 0.0 ? busy / elapsed : 0.0) << endl
+     << "  fairness:    " << setprecision(4)
+     << (sq > 0.0 ? sum * sum / (_tenant.size() * sq) : 1.0)
+     << " (Jain index of disk time / weight)" << endl
+     << endl;
+
+  for (size_t t=0; t<_tenant.size(); t++) {
+    const Tenant *tn = _tenant[t];
+    double mbs = elapsed > 0.0 ? tn->bytes / elapsed / 1e6 : 0.0;
+
+    os << "tenant " << t << " (" << tn->name << ", weight "
+       << setprecision(2) << tn->weight << "):" << endl
+       << "  requests:    " << tn->requests << endl
+       << "  MB/s:        " << setprecision(6) << mbs << endl
+       << "  share:       " << setprecision(2)
+       << (busy > 0.0 ? 100.0 * sim_seconds(tn->busy) / busy : 0.0)
+       << "% of the disk time (weight " << 100.0 * tn->weight / weights
+       << "%)" << endl;
+    tn->service.print(os, "service");
+    tn->response.print(os, "response");
+    if (alone) {
+      double a = (*alone)[t], m = tn->response.mean();
+      os << "  alone:       mean response " << setprecision(6) << a
+         << " (slowdown " << setprecision(2) << (a > 0.0 ? m / a : 0.0)
+         << "x)" << endl;
+    }
+    os << endl;
+  }
+}
@@ -0,0 +1,192 @@
+//------------------------------------------------------------------------------
+/// @brief multi-tenant replay with fair-share scheduling
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_TENANT_H__
+#define __CA_TENANT_H__
+
+#include <deque>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "disk.h"
+#include "stats.h"
+#include "workload.h"
+using namespace std;
+
+/// @brief policy choosing the tenant whose request is served next
+typedef enum {
+  FAIR_FIFO,                        ///< global arrival order (no isolation)
+  FAIR_WFQ,                         ///< weighted fair queueing on bytes
+  FAIR_BUDGET,                      ///< round-robin byte budgets (BFQ-like)
+} FairScheduler;
+
+/// @brief a tenant: trace file and share of the disk
+typedef struct _tenant_spec {
+  string path;                      ///< trace file (.bz2 is decompressed)
+  double weight;                    ///< relative share
+} TenantSpec;
+
+//------------------------------------------------------------------------------
+/// @brief configuration of a multi-tenant replay
+///
+/// A configuration is parsed from a comma-separated list of key=value pairs
+/// (sizes accept K, M, G suffixes):
+///
+/// - trace=<path>[:<weight>]        add a tenant replaying the trace file
+///                                  <path> with the given weight (default 1).
+///                                  Repeat for every tenant.
+/// - sched=fifo|wfq|budget          fair-share scheduler
+/// - budget=<bytes>                 bytes a tenant of weight 1 may transfer
+///                                  per turn (budget scheduler)
+/// - align=0|1                      shift every trace to start at time 0
+///
+typedef struct _tenant_config {
+  vector<TenantSpec> tenants;       ///< tenants
+  FairScheduler sched;              ///< scheduler
+  uint64 budget;                    ///< budget per turn and unit of weight
+  bool   align;                     ///< start all traces at time 0
+} TenantConfig;
+
+/// @brief initialize @a cfg with default values
+void tenant_defaults(TenantConfig *cfg);
+
+/// @brief parse @a spec into @a cfg (on top of the values already in @a cfg)
+/// @retval true if @a spec was parsed successfully, false otherwise
+bool tenant_parse(const char *spec, TenantConfig *cfg);
+
+
+//------------------------------------------------------------------------------
+/// @brief concurrent replay of several traces against one disk
+///
+/// TenantReplay merges the request streams of its tenants by timestamp and
+/// replays them open loop against a single disk. Requests wait in per-tenant
+/// queues while the disk is busy; whenever the disk becomes idle, the
+/// scheduler picks the tenant whose oldest request is served next:
+///
+/// - FAIR_FIFO serves the requests in the order of arrival, so a busy tenant
+///   delays everybody else (the noisy-neighbour baseline),
+/// - FAIR_WFQ implements start-time fair queueing: a request is tagged with
+///   the virtual time at which its tenant is entitled to it, and each byte
+///   advances the tag by 1/weight,
+/// - FAIR_BUDGET serves one tenant until it has used up a budget proportional
+///   to its weight or has no more requests queued, then moves on to the next
+///   backlogged tenant in round-robin order.
+///
+/// Every tenant gets its own service and response time statistics.
+///
+class TenantReplay {
+  public:
+    /// @name constructor/destructor
+    /// @{
+
+    /// @brief constructor
+    /// @param disk disk to serve the requests
+    /// @param cfg configuration
+    TenantReplay(Disk *disk, const TenantConfig &cfg);
+
+    /// @brief destructor
+    ~TenantReplay(void);
+
+    /// @}
+
+
+    /// @name replay
+    /// @{
+
+    /// @brief read the traces of all tenants
+    /// @retval true on success, false if a trace cannot be read
+    bool   load(void);
+
+    /// @brief replay the traces
+    void   run(void);
+
+    /// @}
+
+
+    /// @name results
+    /// @{
+
+    /// @brief number of tenants
+    size_t tenants(void) const { return _tenant.size(); }
+
+    /// @brief requests of tenant @a t (rewound)
+    MemoryWorkload *trace(size_t t) const { return _tenant[t]->trace; }
+
+    /// @brief response times of tenant @a t
+    const LatencyStats &response(size_t t) const
+    {
+      return _tenant[t]->response;
+    }
+
+    /// @brief print a summary of the replay to @a os. With @a alone, the mean
+    ///        response time of every tenant replayed alone is shown as well.
+    void   report(ostream &os, const vector<double> *alone=NULL) const;
+
+    /// @}
+
+
+  protected:
+    /// @brief state of a tenant
+    typedef struct _tenant {
+      string name;                  ///< name (trace file)
+      double weight;                ///< share of the disk
+      MemoryWorkload *trace;        ///< requests
+      int64  origin;                ///< origin of the request times (s)
+      deque<Request> queue;         ///< requests waiting for the disk
+      double finish;                ///< WFQ: finish tag of the last request
+      deque<double> start;          ///< WFQ: start tags of the queue
+      uint64 requests;              ///< requests served
+      uint64 bytes;                 ///< bytes transferred
+      SimTime busy;                 ///< disk time used
+      LatencyStats service;         ///< service times
+      LatencyStats response;        ///< response times
+    } Tenant;
+
+    TenantConfig _cfg;              ///< configuration
+    Disk  *_disk;                   ///< disk serving the requests
+    vector<Tenant*> _tenant;        ///< tenants
+    double _vtime;                  ///< WFQ: virtual time
+    size_t _active;                 ///< budget: tenant being served
+    uint64 _left;                   ///< budget: bytes left of its turn
+    SimTime _first;                 ///< arrival time of the first request
+    SimTime _last;                  ///< completion time of the last request
+    uint32 _trace_device;           ///< device in the trace (see tracing.h)
+
+    /// @brief queue request @a req of tenant @a t
+    void   enqueue(size_t t, const Request &req);
+
+    /// @brief choose the tenant to be served next (at least one is backlogged)
+    size_t pick(void);
+};
+
+#endif // __CA_TENANT_H__
@@ -0,0 +1,270 @@
+//------------------------------------------------------------------------------
+/// @brief time-indexed trace files
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+
+#include "traceindex.h"
+#include "compress.h"
+#include "options.h"
+#include "snapshot.h"
+using namespace std;
+
+#define INDEX_MAGIC "disklab-index"   ///< first word of an index file
+#define INDEX_VERSION 1               ///< version of the index format
+
+//------------------------------------------------------------------------------
+// WindowConfig
+//
+void window_defaults(WindowConfig *cfg)
+{
+  cfg->path   = "";
+  cfg->from   = 0.0;
+  cfg->to     = 0.0;
+  cfg->to_end = true;
+  cfg->warm   = 10.0;
+}
+
+static bool parse_option(const char *key, const char *val, void *ctx)
+{
+  WindowConfig *cfg = (WindowConfig*)ctx;
+  char *end;
+
+  if (strcmp(key, "trace") == 0) {
+    cfg->path = val;
+    return *val != '\0';
+  }
+  if (strcmp(key, "from") == 0) {
+    cfg->from = strtod(val, &end);
+    return (end != val) && (*end == '\0');
+  }
+  if (strcmp(key, "to") == 0) {
+    cfg->to = strtod(val, &end);
+    cfg->to_end = false;
+    return (end != val) && (*end == '\0');
+  }
+  if (strcmp(key, "warm") == 0) {
+    cfg->warm = strtod(val, &end);
+    return (end != val) && (*end == '\0') && (cfg->warm >= 0.0);
+  }
+
+  return false;
+}
+
+bool window_parse(const char *spec, WindowConfig *cfg)
+{
+  if (!parse_options(spec, parse_option, cfg, "window")) return false;
+
+  if (cfg->path.empty()) {
+    cout << "no indexed trace given (trace=<path>)" << endl;
+    return false;
+  }
+  return true;
+}
+
+
+//------------------------------------------------------------------------------
+// TraceIndex
+//
+bool TraceIndex::load(const string &path)
+{
+  ifstream is((path + ".idx").c_str());
+  string magic;
+  uint32 version;
+
+  is >> magic >> version;
+  if (!is.good() || (magic != INDEX_MAGIC) || (version != INDEX_VERSION)) {
+    cout << "no valid index '" << path << ".idx' (see trace_ingest)" << endl;
+    return false;
+  }
+
+  string key;
+  is >> key >> _origin;
+  if (!is.good() || (key != "origin")) {
+    cout << "corrupt index '" << path << ".idx'" << endl;
+    return false;
+  }
+
+  _chunk.clear();
+  IndexChunk c;
+  while (is >> c.first >> c.last >> c.offset >> c.length >> c.records) {
+    _chunk.push_back(c);
+  }
+  if (!is.eof()) {
+    cout << "corrupt index '" << path << ".idx'" << endl;
+    return false;
+  }
+  return true;
+}
+
+bool TraceIndex::save(const string &path) const
+{
+  ofstream os((path + ".idx").c_str());
+  os << INDEX_MAGIC << " " << INDEX_VERSION << endl
+     << "origin " << _origin << endl;
+  for (size_t i=0; i<_chunk.size(); i++) {
+    const IndexChunk &c = _chunk[i];
+    os << c.first << " " << c.last << " " << c.offset << " " << c.length
+       << " " << c.records << endl;
+  }
+  os.close();
+  if (os.fail()) {
+    cout << "cannot write the index '" << path << ".idx'" << endl;
+    return false;
+  }
+  return true;
+}
+
+SimTime TraceIndex::last(void) const
+{
+  SimTime t = 0;
+  for (size_t i=0; i<_chunk.size(); i++) {
+    if (_chunk[i].last > t) t = _chunk[i].last;
+  }
+  return t;
+}
+
+
+//------------------------------------------------------------------------------
+// IndexedTrace
+//
+IndexedTrace::IndexedTrace(const WindowConfig &cfg)
+  : _cfg(cfg), _lo(0), _from(0), _to(0), _next(0),
+    _count(0), _blocks(0), _records(0)
+{
+}
+
+bool IndexedTrace::open(void)
+{
+  if (!_index.load(_cfg.path)) return false;
+
+  SimTime end = _index.last();
+  _from = _cfg.from < 0.0 ? end + sim_time(_cfg.from) : sim_time(_cfg.from);
+  if (_cfg.to_end) _to = end + 1;
+  else _to = _cfg.to < 0.0 ? end + sim_time(_cfg.to) : sim_time(_cfg.to);
+  _lo = _from - sim_time(_cfg.warm);
+
+  if (_to <= _from) {
+    cout << "empty window" << endl;
+    return false;
+  }
+  return true;
+}
+
+bool IndexedTrace::load_block(void)
+{
+  // blocks outside [_lo, _to) are not read
+  while ((_next < _index.chunks()) &&
+         ((_index.chunk(_next).last < _lo) ||
+          (_index.chunk(_next).first >= _to))) {
+    _next++;
+  }
+  if (_next == _index.chunks()) return false;
+
+  const IndexChunk &c = _index.chunk(_next++);
+  string packed, data;
+  if (!read_range(_cfg.path, c.offset, c.length, &packed) ||
+      !bz2_decompress(packed, &data)) {
+    cout << "cannot decompress block " << _next - 1 << " of '" << _cfg.path
+         << "'" << endl;
+    return false;
+  }
+
+  _block.clear();
+  _block.str(data);
+  _blocks++;
+  return true;
+}
+
+bool IndexedTrace::next(Request *req)
+{
+  string ts;
+  int64 sec;
+  SimTime ns;
+
+  while (true) {
+    if (!(_block >> ts >> req->rw >> req->address >> req->size)) {
+      if (!load_block()) return false;
+      continue;
+    }
+    _records++;
+
+    if (!TraceWorkload::parse_timestamp(ts.c_str(), &sec, &ns)) {
+      cout << "invalid timestamp '" << ts << "' in '" << _cfg.path << "'"
+           << endl;
+      return false;
+    }
+    req->ts = (sec - _index.origin()) * SIM_SECOND + ns;
+    if ((req->ts < _lo) || (req->ts >= _to)) continue;
+
+    _count++;
+    return true;
+  }
+}
+
+void IndexedTrace::save(Snapshot &s) const
+{
+  s.begin("window");
+  s.put(_count);
+}
+
+bool IndexedTrace::restore(Snapshot &s)
+{
+  if (!s.expect("window")) return false;
+  uint64 n = s.get_u64();
+
+  Request req;
+  while ((_count < n) && next(&req));
+  return s.good() && (_count == n);
+}
+
+void IndexedTrace::print_stats(ostream &os) const
+{
+  uint64 total = 0;
+  for (size_t i=0; i<_index.chunks(); i++) total += _index.chunk(i).records;
+
+  os << "window: " << endl
+     << "  trace:       " << _cfg.path << " (origin " << _index.origin()
+     << ")" << endl
+     << "  window:      " << dec << fixed << setprecision(6)
+     << sim_seconds(_from) << " to " << sim_seconds(_to) << " s, warm-up from "
+     << sim_seconds(_lo) << " s" << endl
+     << "  blocks:      " << _blocks << " of " << _index.chunks()
+     << " decompressed, " << _records << " of " << total
+     << " requests parsed" << endl
+     << endl;
+}
@@ -0,0 +1,185 @@
+//------------------------------------------------------------------------------
+/// @brief time-indexed trace files
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_TRACEINDEX_H__
+#define __CA_TRACEINDEX_H__
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "disk.h"
+#include "workload.h"
+using namespace std;
+
+
+//------------------------------------------------------------------------------
+/// @brief configuration of a windowed replay
+///
+/// A configuration is parsed from a comma-separated list of key=value pairs.
+/// Times are seconds from the origin of the trace (the whole second of its
+/// first request); negative times count back from its last request.
+///
+/// - trace=<path>                   indexed trace (see trace_ingest)
+/// - from=<s>                       start of the window
+/// - to=<s>                         end of the window (default: end of trace)
+/// - warm=<s>                       length of the warm-up before the window
+///
+typedef struct _window_config {
+  string path;                      ///< indexed trace
+  double from;                      ///< start of the window
+  double to;                        ///< end of the window
+  bool   to_end;                    ///< the window extends to the end
+  double warm;                      ///< length of the warm-up
+} WindowConfig;
+
+/// @brief initialize @a cfg with default values
+void window_defaults(WindowConfig *cfg);
+
+/// @brief parse @a spec into @a cfg (on top of the values already in @a cfg)
+/// @retval true if @a spec was parsed successfully, false otherwise
+bool window_parse(const char *spec, WindowConfig *cfg);
+
+
+/// @brief one block of an indexed trace
+typedef struct _index_chunk {
+  SimTime first;                    ///< earliest request (from the origin)
+  SimTime last;                     ///< latest request (from the origin)
+  uint64  offset;                   ///< byte offset of the compressed block
+  uint64  length;                   ///< bytes of the compressed block
+  uint64  records;                  ///< number of requests
+} IndexChunk;
+
+//------------------------------------------------------------------------------
+/// @brief sparse time index of a block-compressed trace
+///
+/// An indexed trace is a bzip2 file made of independent streams: one for
+/// the geometry line and one for each block of requests. As a sequence of
+/// streams it is still a valid .bz2 file, so bzcat and the other modes read
+/// it unchanged. The index is kept in a text sidecar, <trace>.idx, with the
+/// origin of the request times and the time range, position, and size of
+/// every block. A block can then be decompressed on its own, so a time
+/// window only costs the blocks it overlaps.
+///
+class TraceIndex {
+  public:
+    /// @brief constructor
+    TraceIndex(void) : _origin(0) {};
+
+    /// @brief read the index of the trace @a path from <path>.idx
+    /// @retval true on success, false otherwise
+    bool   load(const string &path);
+
+    /// @brief write the index of the trace @a path to <path>.idx
+    /// @retval true on success, false otherwise
+    bool   save(const string &path) const;
+
+    /// @brief set the origin of the request times
+    void   set_origin(int64 origin) { _origin = origin; }
+
+    /// @brief append block @a c
+    void   add(const IndexChunk &c) { _chunk.push_back(c); }
+
+    /// @brief origin of the request times (seconds in the trace's timebase)
+    int64  origin(void) const { return _origin; }
+
+    /// @brief number of blocks
+    size_t chunks(void) const { return _chunk.size(); }
+
+    /// @brief block @a i
+    const IndexChunk &chunk(size_t i) const { return _chunk[i]; }
+
+    /// @brief latest request of the trace (from the origin)
+    SimTime last(void) const;
+
+  protected:
+    int64 _origin;                  ///< whole second of the first request
+    vector<IndexChunk> _chunk;      ///< blocks in file order
+};
+
+
+//------------------------------------------------------------------------------
+/// @brief requests of a time window of an indexed trace
+///
+/// IndexedTrace returns the requests of an indexed trace that arrive in
+/// [from - warm, to), with times relative to the origin of the trace. Only
+/// the blocks whose time range overlaps this interval are decompressed, one
+/// at a time. The requests before from warm up the device state; the replay
+/// tells them apart with window_start().
+///
+class IndexedTrace : public Workload {
+  public:
+    /// @brief constructor
+    /// @param cfg window
+    IndexedTrace(const WindowConfig &cfg);
+
+    /// @brief load the index and resolve the window
+    /// @retval true on success, false otherwise
+    bool   open(void);
+
+    /// @brief get the next request of the window
+    virtual bool next(Request *req);
+
+    /// @brief start of the window (from the origin)
+    SimTime window_start(void) const { return _from; }
+
+    /// @brief origin of the request times
+    int64  origin(void) const { return _index.origin(); }
+
+    /// @brief save the number of requests read to snapshot @a s
+    virtual void save(Snapshot &s) const;
+
+    /// @brief skip the requests read before the snapshot @a s was taken
+    virtual bool restore(Snapshot &s);
+
+    /// @brief print the window and the blocks read to @a os
+    void   print_stats(ostream &os) const;
+
+  protected:
+    WindowConfig _cfg;              ///< configuration
+    TraceIndex _index;              ///< index of the trace
+    SimTime _lo;                    ///< start of the warm-up
+    SimTime _from;                  ///< start of the window
+    SimTime _to;                    ///< end of the window
+    size_t  _next;                  ///< next block to consider
+    istringstream _block;           ///< requests of the current block
+    uint64  _count;                 ///< requests returned
+    uint64  _blocks;                ///< blocks decompressed
+    uint64  _records;               ///< requests parsed
+
+    /// @brief decompress the next block that overlaps the interval
+    /// @retval true if a block was loaded, false at the end
+    bool   load_block(void);
+};
+
+#endif // __CA_TRACEINDEX_H__
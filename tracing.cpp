@@ -0,0 +1,272 @@
+//------------------------------------------------------------------------------
+/// @brief per-request phase tracing
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <atomic>
+#include <iostream>
+
+#include "tracing.h"
+#include "options.h"
+using namespace std;
+
+//------------------------------------------------------------------------------
+// TracingConfig
+//
+void tracing_defaults(TracingConfig *cfg)
+{
+  cfg->path   = "trace.json";
+  cfg->events = 1ULL << 20;
+}
+
+static bool parse_option(const char *key, const char *val, void *ctx)
+{
+  TracingConfig *cfg = (TracingConfig*)ctx;
+
+  if (strcmp(key, "out") == 0) {
+    cfg->path = val;
+    return *val != '\0';
+  }
+  if (strcmp(key, "events") == 0) {
+    return parse_size(val, &cfg->events) && (cfg->events > 0) &&
+           (cfg->events <= TRACE_MAX_EVENTS);
+  }
+
+  return false;
+}
+
+bool tracing_parse(const char *spec, TracingConfig *cfg)
+{
+  return parse_options(spec, parse_option, cfg, "tracing");
+}
+
+
+//------------------------------------------------------------------------------
+// event buffer
+//
+/// @brief one recorded phase
+typedef struct _trace_event {
+  SimTime start;                    ///< begin of the phase
+  SimTime end;                      ///< end of the phase
+  uint64  request;                  ///< request id
+  uint64  arg;                      ///< track, power state, or address
+  uint64  bytes;                    ///< bytes transferred
+  uint32  phase;                    ///< TracePhase
+  uint32  lane;                     ///< device (1, 2, ...)
+} TraceEvent;
+
+static const char *phase_name[TP_PHASES] = {
+  "read", "write", "queue", "wake-up", "buffer hit",
+  "seek", "rotation", "read", "write",
+};
+
+static TracingConfig   trace_cfg;
+static TraceEvent     *trace_events = NULL;   ///< preallocated events
+static atomic<uint64>  trace_next(0);         ///< next free slot
+static atomic<uint32>  trace_lanes(0);        ///< devices handed out
+static __thread uint64 trace_id = 0;          ///< request of this thread
+static __thread uint32 trace_lane = 0;        ///< device of this thread
+static __thread uint32 trace_own = 0;         ///< own device of this thread
+
+bool trace_open(const TracingConfig &cfg)
+{
+  trace_events = NULL;
+  if ((cfg.events > 0) && (cfg.events <= SIZE_MAX / sizeof(TraceEvent))) {
+    trace_events = (TraceEvent*)malloc(cfg.events * sizeof(TraceEvent));
+  }
+  if (trace_events == NULL) {
+    cout << "cannot allocate " << cfg.events << " trace events" << endl;
+    return false;
+  }
+  trace_cfg = cfg;
+  trace_next = 0;
+  return true;
+}
+
+bool trace_enabled(void)
+{
+  return trace_events != NULL;
+}
+
+uint32 trace_device(void)
+{
+  return trace_lanes.fetch_add(1) + 1;
+}
+
+void trace_begin(uint32 device, uint64 id)
+{
+  if (device == 0) {
+    if (trace_own == 0) trace_own = trace_device();
+    device = trace_own;
+  }
+  trace_lane = device;
+  trace_id = id;
+}
+
+/// reserve a slot and fill in the common fields; NULL if the buffer is full
+static TraceEvent *record(TracePhase phase, SimTime start, SimTime end)
+{
+  if (trace_events == NULL) return NULL;
+
+  uint64 i = trace_next.fetch_add(1, memory_order_relaxed);
+  if (i >= trace_cfg.events) return NULL;
+
+  if (trace_lane == 0) trace_begin(0, trace_id);
+
+  TraceEvent *e = &trace_events[i];
+  e->start   = start;
+  e->end     = end;
+  e->request = trace_id;
+  e->phase   = phase;
+  e->lane    = trace_lane;
+  return e;
+}
+
+void trace_request(char rw, SimTime arrival, SimTime start, SimTime end,
+                   uint64 address, uint64 size)
+{
+  TraceEvent *e = record(rw == 'w' ? TP_WRITE_REQUEST : TP_READ_REQUEST,
+                         arrival, end);
+  if (e == NULL) return;
+  e->arg   = address;
+  e->bytes = size;
+
+  if (start > arrival) {
+    e = record(TP_QUEUE, arrival, start);
+    if (e == NULL) return;
+    e->arg   = 0;
+    e->bytes = 0;
+  }
+}
+
+void trace_span(TracePhase phase, SimTime start, SimTime end, uint64 arg,
+                uint64 bytes)
+{
+  TraceEvent *e = record(phase, start, end);
+  if (e == NULL) return;
+  e->arg   = arg;
+  e->bytes = bytes;
+}
+
+/// print @a t in microseconds with three decimals
+static void print_us(FILE *f, SimTime t)
+{
+  if (t < 0) {
+    fputc('-', f);
+    t = -t;
+  }
+  fprintf(f, "%lld.%03lld", (long long)(t / 1000), (long long)(t % 1000));
+}
+
+bool trace_close(void)
+{
+  if (trace_events == NULL) return true;
+
+  uint64 n = trace_next.load();
+  uint64 dropped = 0;
+  if (n > trace_cfg.events) {
+    dropped = n - trace_cfg.events;
+    n = trace_cfg.events;
+  }
+
+  FILE *f = fopen(trace_cfg.path.c_str(), "w");
+  if (f == NULL) {
+    cout << "cannot write the trace to '" << trace_cfg.path << "'" << endl;
+    free(trace_events);
+    trace_events = NULL;
+    return false;
+  }
+
+  fprintf(f, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+  uint32 lanes = trace_lanes.load();
+  for (uint32 l=1; l<=lanes; l++) {
+    fprintf(f, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%u,"
+               "\"args\":{\"name\":\"device %u\"}},\n", l, l);
+    fprintf(f, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":1,"
+               "\"args\":{\"name\":\"media\"}},\n", l);
+  }
+
+  for (uint64 i=0; i<n; i++) {
+    const TraceEvent &e = trace_events[i];
+    const char *name = phase_name[e.phase];
+
+    if (e.phase <= TP_QUEUE) {
+      // async slice of the request, the queue wait nests inside
+      fprintf(f, "{\"name\":\"%s\",\"cat\":\"request\",\"ph\":\"b\","
+                 "\"id\":%llu,\"pid\":%u,\"ts\":", name,
+              (unsigned long long)e.request, e.lane);
+      print_us(f, e.start);
+      if (e.phase == TP_QUEUE) {
+        fprintf(f, "},\n");
+      } else {
+        fprintf(f, ",\"args\":{\"address\":%llu,\"size\":%llu}},\n",
+                (unsigned long long)e.arg, (unsigned long long)e.bytes);
+      }
+      fprintf(f, "{\"name\":\"%s\",\"cat\":\"request\",\"ph\":\"e\","
+                 "\"id\":%llu,\"pid\":%u,\"ts\":", name,
+              (unsigned long long)e.request, e.lane);
+      print_us(f, e.end);
+      fprintf(f, "},\n");
+    } else {
+      fprintf(f, "{\"name\":\"%s\",\"cat\":\"media\",\"ph\":\"X\","
+                 "\"pid\":%u,\"tid\":1,\"ts\":", name, e.lane);
+      print_us(f, e.start);
+      fprintf(f, ",\"dur\":");
+      print_us(f, e.end - e.start);
+      fprintf(f, ",\"args\":{\"request\":%llu,\"%s\":%llu,\"bytes\":%llu}},\n",
+              (unsigned long long)e.request,
+              e.phase == TP_WAKE ? "state" : "track",
+              (unsigned long long)e.arg, (unsigned long long)e.bytes);
+    }
+  }
+  // the trailing metadata event avoids a comma after the last event
+  fprintf(f, "{\"name\":\"trace_info\",\"ph\":\"M\",\"pid\":0,"
+             "\"args\":{\"events\":%llu,\"dropped\":%llu}}\n]}\n",
+          (unsigned long long)n, (unsigned long long)dropped);
+
+  bool ok = ferror(f) == 0;
+  ok = (fclose(f) == 0) && ok;
+  if (!ok) {
+    cout << "cannot write the trace to '" << trace_cfg.path << "'" << endl;
+  }
+
+  cout << "trace:       " << n << " events written to " << trace_cfg.path;
+  if (dropped > 0) cout << " (" << dropped << " dropped, buffer full)";
+  cout << endl;
+
+  free(trace_events);
+  trace_events = NULL;
+  return ok;
+}
@@ -0,0 +1,144 @@
+//------------------------------------------------------------------------------
+/// @brief per-request phase tracing
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_TRACING_H__
+#define __CA_TRACING_H__
+
+#include <string>
+
+#include "disk.h"
+using namespace std;
+
+
+/// @brief phases of a request
+typedef enum {
+  TP_READ_REQUEST,                  ///< read request, arrival to completion
+  TP_WRITE_REQUEST,                 ///< write request, arrival to completion
+  TP_QUEUE,                         ///< wait for the disk
+  TP_WAKE,                          ///< wake-up from an idle power state
+  TP_HIT,                           ///< transfer from the drive buffer
+  TP_SEEK,                          ///< head movement
+  TP_ROTATE,                        ///< rotational wait
+  TP_READ,                          ///< media read of one track
+  TP_WRITE,                         ///< media write of one track
+  TP_PHASES
+} TracePhase;
+
+//------------------------------------------------------------------------------
+/// @brief configuration of the tracing
+///
+/// A configuration is parsed from a comma-separated list of key=value pairs
+/// (sizes accept K, M, G suffixes):
+///
+/// - out=<path>                     trace-event JSON file
+/// - events=<n>                     capacity of the event buffer (at most
+///                                  TRACE_MAX_EVENTS); later events are
+///                                  dropped
+///
+#define TRACE_MAX_EVENTS (1ULL << 30) ///< largest event buffer (48 GB)
+
+typedef struct _tracing_config {
+  string path;                      ///< output file
+  uint64 events;                    ///< capacity of the event buffer
+} TracingConfig;
+
+/// @brief initialize @a cfg with default values
+void tracing_defaults(TracingConfig *cfg);
+
+/// @brief parse @a spec into @a cfg (on top of the values already in @a cfg)
+/// @retval true if @a spec was parsed successfully, false otherwise
+bool tracing_parse(const char *spec, TracingConfig *cfg);
+
+
+/// @name tracing
+///
+/// The disk models and the replays record the phases of each request into
+/// one preallocated buffer of events. Recording reserves a slot with an
+/// atomic increment, so threads serving different devices need no lock; once
+/// the buffer is full, further events are counted and dropped. Each replay
+/// obtains a device number with trace_device(), and the events carry the
+/// device and the id of the request set with trace_begin() by the thread
+/// that serves it, so that replays compared in one run do not mix.
+/// trace_close() writes the buffer in the Chrome trace-event JSON format
+/// (chrome://tracing, ui.perfetto.dev) with one process per device:
+/// requests and their queue wait as async slices, and the media phases as
+/// complete slices on one track.
+///
+/// The hooks in the simulator use the TRACE_* macros, which compile to
+/// nothing unless DL_TRACE is defined (make TRACE=1).
+/// @{
+
+/// @brief allocate the event buffer
+/// @retval true on success, false otherwise
+bool trace_open(const TracingConfig &cfg);
+
+/// @brief true if events are being recorded
+bool trace_enabled(void);
+
+/// @brief write the events to the output file and free the buffer
+/// @retval true on success, false otherwise
+bool trace_close(void);
+
+/// @brief a new device number (1, 2, ...)
+uint32 trace_device(void);
+
+/// @brief attribute the following media phases of this thread to request
+///        @a id of @a device (0: a device of its own for this thread)
+void trace_begin(uint32 device, uint64 id);
+
+/// @brief record a request served from @a start to @a end that arrived at
+///        @a arrival
+void trace_request(char rw, SimTime arrival, SimTime start, SimTime end,
+                   uint64 address, uint64 size);
+
+/// @brief record phase @a phase from @a start to @a end; @a arg is the track
+///        (media phases) or the power state (TP_WAKE)
+void trace_span(TracePhase phase, SimTime start, SimTime end, uint64 arg,
+                uint64 bytes);
+
+/// @}
+
+#ifdef DL_TRACE
+#define TRACE_DEVICE()                      trace_device()
+#define TRACE_BEGIN(device, id)             trace_begin(device, id)
+#define TRACE_REQUEST(rw, arrival, start, end, address, size) \
+  trace_request(rw, arrival, start, end, address, size)
+#define TRACE_SPAN(phase, start, end, arg, bytes) \
+  trace_span(phase, start, end, arg, bytes)
+#else
+#define TRACE_DEVICE()                      0
+#define TRACE_BEGIN(device, id)             do { } while (0)
+#define TRACE_REQUEST(rw, arrival, start, end, address, size) do { } while (0)
+#define TRACE_SPAN(phase, start, end, arg, bytes) do { } while (0)
+#endif
+
+#endif // __CA_TRACING_H__
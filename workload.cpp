@@ -0,0 +1,423 @@
+//------------------------------------------------------------------------------
+/// @brief I/O request streams
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <iostream>
+#include <algorithm>
+#include <string>
+
+#include "workload.h"
+#include "options.h"
+#include "snapshot.h"
+using namespace std;
+
+//------------------------------------------------------------------------------
+// TraceWorkload
+//
+bool TraceWorkload::parse_timestamp(const char *str, int64 *sec, SimTime *ns)
+{
+  const char *p = str;
+  bool neg = *p == '-';
+  if ((*p == '-') || (*p == '+')) p++;
+
+  int64  s = 0;
+  SimTime f = 0, scale = SIM_SECOND;
+  const char *digits = p;
+  while ((*p >= '0') && (*p <= '9')) s = 10 * s + (*p++ - '0');
+  if (*p == '.') {
+    p++;
+    while ((*p >= '0') && (*p <= '9')) {
+      scale /= 10;
+      f += (*p++ - '0') * scale;
+      if (scale == 0) {           // round at the nanosecond
+        if (p[-1] >= '5') f++;
+        while ((*p >= '0') && (*p <= '9')) p++;
+        break;
+      }
+    }
+  }
+  if (p == digits) return false;
+
+  if (*p != '\0') {
+    // exponent notation: no exact decimal, go through double
+    char *end;
+    double t = strtod(str, &end);
+    if (*end != '\0') return false;
+    double whole = floor(t);
+    *sec = (int64)whole;
+    *ns  = sim_time(t - whole);
+  } else if (neg && (f > 0)) {
+    *sec = -s - 1;
+    *ns  = SIM_SECOND - f;
+  } else {
+    *sec = neg ? -s : s;
+    *ns  = f;
+  }
+  if (*ns >= SIM_SECOND) {
+    *sec += 1;
+    *ns  -= SIM_SECOND;
+  }
+  return true;
+}
+
+bool TraceWorkload::next(Request *req)
+{
+  string ts;
+  _is >> ts >> req->rw >> req->address >> req->size;
+  if (_is.fail()) return false;
+
+  int64 sec;
+  SimTime ns;
+  if (!parse_timestamp(ts.c_str(), &sec, &ns)) {
+    _is.setstate(ios::failbit);
+    return false;
+  }
+  if (_count == 0) _origin = sec;
+  req->ts = (sec - _origin) * SIM_SECOND + ns;
+  _count++;
+  return true;
+}
+
+void TraceWorkload::save(Snapshot &s) const
+{
+  s.begin("trace");
+  s.put(_count);
+}
+
+bool TraceWorkload::restore(Snapshot &s)
+{
+  if (!s.expect("trace")) return false;
+  uint64 n = s.get_u64();
+
+  // the stream may be a pipe: skip the requests
+  Request req;
+  while ((_count < n) && next(&req));
+  return s.good() && (_count == n);
+}
+
+
+//------------------------------------------------------------------------------
+// MemoryWorkload
+//
+MemoryWorkload::MemoryWorkload(Workload *source)
+  : _pos(0)
+{
+  Request req;
+  while (source->next(&req)) _req.push_back(req);
+}
+
+bool MemoryWorkload::next(Request *req)
+{
+  if (_pos >= _req.size()) return false;
+  *req = _req[_pos++];
+  return true;
+}
+
+void MemoryWorkload::save(Snapshot &s) const
+{
+  s.begin("memory");
+  s.put((uint64)_pos);
+}
+
+bool MemoryWorkload::restore(Snapshot &s)
+{
+  if (!s.expect("memory")) return false;
+  _pos = s.get_u64();
+  return s.good() && (_pos <= _req.size());
+}
+
+
+//------------------------------------------------------------------------------
+// Random
+//
+Random::Random(uint64 seed)
+{
+  // initialize state with splitmix64
+  for (int i=0; i<4; i++) {
+    uint64 z = (seed += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    _s[i] = z ^ (z >> 31);
+  }
+}
+
+double Random::exponential(double mean)
+{
+  return -mean * log(1.0 - uniform());
+}
+
+void Random::save(Snapshot &s) const
+{
+  for (int i=0; i<4; i++) s.put(_s[i]);
+}
+
+void Random::restore(Snapshot &s)
+{
+  for (int i=0; i<4; i++) _s[i] = s.get_u64();
+}
+
+
+//------------------------------------------------------------------------------
+// WorkloadConfig
+//
+void workload_defaults(WorkloadConfig *cfg)
+{
+  cfg->pattern       = PAT_UNIFORM;
+  cfg->stride        = 1048576;
+  cfg->theta         = 0.99;
+  cfg->extents       = 1024;
+  cfg->read_fraction = 1.0;
+  cfg->size_dist     = SIZE_FIXED;
+  cfg->size_min      = 4096;
+  cfg->size_max      = 4096;
+  cfg->size_mean     = 4096.0;
+  cfg->arrival       = ARR_POISSON;
+  cfg->iops          = 100.0;
+  cfg->burst         = 64;
+  cfg->idle          = 1.0;
+  cfg->iodepth       = 1;
+  cfg->count         = 1000000;
+  cfg->seed          = 1;
+}
+
+static bool parse_option(const char *key, const char *val, void *ctx)
+{
+  WorkloadConfig *cfg = (WorkloadConfig*)ctx;
+
+  if (strcmp(key, "pattern") == 0) {
+    if      (strcmp(val, "uniform") == 0)    cfg->pattern = PAT_UNIFORM;
+    else if (strcmp(val, "sequential") == 0) cfg->pattern = PAT_SEQUENTIAL;
+    else if (strcmp(val, "strided") == 0)    cfg->pattern = PAT_STRIDED;
+    else if (strcmp(val, "zipf") == 0)       cfg->pattern = PAT_ZIPF;
+    else return false;
+    return true;
+  }
+  if (strcmp(key, "stride") == 0) {
+    return sscanf(val, "%llu", &cfg->stride) == 1;
+  }
+  if (strcmp(key, "theta") == 0)   return sscanf(val, "%lf", &cfg->theta) == 1;
+  if (strcmp(key, "extents") == 0) {
+    return sscanf(val, "%u", &cfg->extents) == 1 && cfg->extents > 0;
+  }
+  if (strcmp(key, "read") == 0) {
+    return sscanf(val, "%lf", &cfg->read_fraction) == 1 &&
+           cfg->read_fraction >= 0.0 && cfg->read_fraction <= 1.0;
+  }
+  if (strcmp(key, "size") == 0) {
+    if (sscanf(val, "uniform:%llu:%llu", &cfg->size_min, &cfg->size_max) == 2) {
+      cfg->size_dist = SIZE_UNIFORM;
+      return cfg->size_min <= cfg->size_max;
+    }
+    if (sscanf(val, "exp:%lf", &cfg->size_mean) == 1) {
+      cfg->size_dist = SIZE_EXP;
+      return cfg->size_mean > 0.0;
+    }
+    if (sscanf(val, "%llu", &cfg->size_min) == 1) {
+      cfg->size_dist = SIZE_FIXED;
+      cfg->size_max = cfg->size_min;
+      return true;
+    }
+    return false;
+  }
+  if (strcmp(key, "arrival") == 0) {
+    if (sscanf(val, "poisson:%lf", &cfg->iops) == 1) {
+      cfg->arrival = ARR_POISSON;
+      return cfg->iops > 0.0;
+    }
+    if (sscanf(val, "bursty:%lf:%u:%lf", &cfg->iops, &cfg->burst,
+               &cfg->idle) == 3) {
+      cfg->arrival = ARR_BURSTY;
+      return cfg->iops > 0.0 && cfg->burst > 0;
+    }
+    if (sscanf(val, "closed:%u", &cfg->iodepth) == 1) {
+      cfg->arrival = ARR_CLOSED;
+      return cfg->iodepth > 0;
+    }
+    return false;
+  }
+  if (strcmp(key, "n") == 0)    return sscanf(val, "%llu", &cfg->count) == 1;
+  if (strcmp(key, "seed") == 0) return sscanf(val, "%llu", &cfg->seed) == 1;
+
+  return false;
+}
+
+bool workload_parse(const char *spec, WorkloadConfig *cfg)
+{
+  return parse_options(spec, parse_option, cfg, "workload");
+}
+
+
+//------------------------------------------------------------------------------
+// SyntheticWorkload
+//
+SyntheticWorkload::SyntheticWorkload(const WorkloadConfig &cfg, uint64 capacity,
+                                     uint32 sector_size)
+  : _cfg(cfg), _rng(cfg.seed), _sectors(capacity / sector_size),
+    _sector_size(sector_size), _generated(0), _next_sector(0), _ts(0)
+{
+  if (_cfg.pattern == PAT_ZIPF) {
+    // cumulative probabilities of the extents ordered by popularity
+    _zipf_cdf.resize(_cfg.extents);
+    double sum = 0.0;
+    for (uint32 r=0; r<_cfg.extents; r++) {
+      sum += 1.0 / pow((double)(r + 1), _cfg.theta);
+      _zipf_cdf[r] = sum;
+    }
+    for (uint32 r=0; r<_cfg.extents; r++) _zipf_cdf[r] /= sum;
+  }
+}
+
+SyntheticWorkload::~SyntheticWorkload(void)
+{
+}
+
+bool SyntheticWorkload::next(Request *req)
+{
+  if (_generated >= _cfg.count) return false;
+  _generated++;
+
+  uint64 sectors = next_size();
+  req->ts      = next_arrival();
+  req->rw      = _rng.uniform() < _cfg.read_fraction ? 'r' : 'w';
+  req->address = next_sector(sectors) * _sector_size;
+  req->size    = sectors * _sector_size;
+
+  return true;
+}
+
+void SyntheticWorkload::save(Snapshot &s) const
+{
+  s.begin("synth");
+  s.put(_cfg.seed);
+  _rng.save(s);
+  s.put(_generated);
+  s.put(_next_sector);
+  s.put(_ts);
+}
+
+bool SyntheticWorkload::restore(Snapshot &s)
+{
+  if (!s.expect("synth")) return false;
+  if (s.get_u64() != _cfg.seed) {
+    cout << "snapshot of a workload with a different seed" << endl;
+    return false;
+  }
+  _rng.restore(s);
+  _generated   = s.get_u64();
+  _next_sector = s.get_u64();
+  _ts          = s.get_i64();
+  return s.good();
+}
+
+uint64 SyntheticWorkload::next_size(void)
+{
+  uint64 bytes;
+
+  switch (_cfg.size_dist) {
+    case SIZE_UNIFORM:
+      bytes = _cfg.size_min + _rng.below(_cfg.size_max - _cfg.size_min + 1);
+      break;
+    case SIZE_EXP:
+      bytes = (uint64)_rng.exponential(_cfg.size_mean);
+      break;
+    default:
+      bytes = _cfg.size_min;
+  }
+
+  uint64 sectors = (bytes + _sector_size - 1) / _sector_size;
+  if (sectors == 0) sectors = 1;
+  if (sectors > _sectors) sectors = _sectors;
+  return sectors;
+}
+
+uint64 SyntheticWorkload::next_sector(uint64 sectors)
+{
+  uint64 last = _sectors - sectors;     // last valid starting sector
+  uint64 s;
+
+  switch (_cfg.pattern) {
+    case PAT_SEQUENTIAL:
+      s = _next_sector <= last ? _next_sector : 0;
+      _next_sector = s + sectors;
+      break;
+
+    case PAT_STRIDED:
+      s = _next_sector <= last ? _next_sector : 0;
+      _next_sector = s + max(_cfg.stride / _sector_size, (uint64)1);
+      break;
+
+    case PAT_ZIPF: {
+      // popularity rank of the extent, scattered over the disk
+      double u = _rng.uniform();
+      uint64 rank = lower_bound(_zipf_cdf.begin(), _zipf_cdf.end(), u) -
+                    _zipf_cdf.begin();
+      if (rank >= _cfg.extents) rank = _cfg.extents - 1;
+      uint64 extent  = (rank * 2654435761ULL) % _cfg.extents;
+      uint64 ext_len = max(_sectors / _cfg.extents, (uint64)1);
+      s = extent * ext_len + _rng.below(ext_len);
+      if (s > last) s = last;
+      break;
+    }
+
+    default:
+      s = _rng.below(last + 1);
+  }
+
+  return s;
+}
+
+SimTime SyntheticWorkload::next_arrival(void)
+{
+  switch (_cfg.arrival) {
+    case ARR_POISSON:
+      _ts += sim_time(_rng.exponential(1.0 / _cfg.iops));
+      break;
+
+    case ARR_BURSTY:
+      // Poisson arrivals within a burst, idle period between bursts
+      if (_generated > 1 && (_generated - 1) % _cfg.burst == 0) {
+        _ts += sim_time(_cfg.idle);
+      }
+      _ts += sim_time(_rng.exponential(1.0 / _cfg.iops));
+      break;
+
+    default:
+      // closed loop: requests are issued on completion of earlier requests
+      break;
+  }
+
+  return _ts;
+}
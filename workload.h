@@ -0,0 +1,334 @@
+//------------------------------------------------------------------------------
+/// @brief I/O request streams
+/// @author Bernhard Egger <bernhard@csap.snu.ac.kr>
+/// @section changelog Change Log
+/// 2026/10/19 Bernhard Egger created
+///
+/// @section license_section License
+/// Copyright (c) 2016, Bernhard Egger
+/// All rights reserved.
+///
+/// Redistribution and use in source and binary forms,  with or without modifi-
+/// cation, are permitted provided that the following conditions are met:
+///
+/// - Redistributions of source code must retain the above copyright notice,
+///   this list of conditions and the following disclaimer.
+/// - Redistributions in binary form must reproduce the above copyright notice,
+///   this list of conditions and the following disclaimer in the documentation
+///   and/or other materials provided with the distribution.
+///
+/// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+/// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,  BUT NOT LIMITED TO,  THE
+/// IMPLIED WARRANTIES OF MERCHANTABILITY  AND FITNESS FOR A PARTICULAR PURPOSE
+/// ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT HOLDER  OR CONTRIBUTORS BE
+/// LIABLE FOR ANY DIRECT,  INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSE-
+/// QUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF  SUBSTITUTE
+/// GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+/// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN  CONTRACT, STRICT
+/// LIABILITY, OR TORT  (INCLUDING NEGLIGENCE OR OTHERWISE)  ARISING IN ANY WAY
+/// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+/// DAMAGE.
+//------------------------------------------------------------------------------
+
+#ifndef __CA_WORKLOAD_H__
+#define __CA_WORKLOAD_H__
+
+#include <iostream>
+#include <vector>
+
+#include "disk.h"
+using namespace std;
+
+///@brief struct describing a single I/O request
+typedef struct _request {
+  SimTime ts;                       ///< arrival time
+  char   rw;                        ///< 'r' for reads, 'w' for writes
+  uint64 address;                   ///< starting address (in bytes)
+  uint64 size;                      ///< number of bytes
+} Request;
+
+//------------------------------------------------------------------------------
+/// @brief source of I/O requests
+///
+/// Workload provides an abstract base class for all request streams (trace
+/// files, synthetic generators, etc).
+///
+class Workload {
+  public:
+    /// @name constructor/destructor
+    /// @{
+
+    /// @brief constructor
+    Workload(void) {};
+
+    /// @brief destructor
+    virtual ~Workload(void) {};
+
+    /// @}
+
+
+    /// @name access methods
+    /// @{
+
+    /// @brief get the next request of the stream
+    /// @param req (output) pointer to result
+    /// @retval true if a request was returned, false at the end of the stream
+    virtual bool next(Request *req) = 0;
+
+    /// @}
+
+
+    /// @name snapshots
+    /// @{
+
+    /// @brief save the position in the stream to snapshot @a s
+    virtual void save(Snapshot &s) const = 0;
+
+    /// @brief restore the position in the stream from snapshot @a s
+    virtual bool restore(Snapshot &s) = 0;
+
+    /// @}
+};
+
+
+//------------------------------------------------------------------------------
+/// @brief request stream read from a trace
+///
+/// TraceWorkload reads requests in the text format of the trace files
+/// ("<time> <r|w> <address> <size>" per line) from an input stream. The
+/// decimal timestamps are converted exactly; request times are relative to
+/// the origin, the whole second of the first timestamp.
+///
+class TraceWorkload : public Workload {
+  public:
+    /// @brief constructor
+    /// @param is input stream positioned at the first request
+    TraceWorkload(istream &is) : _is(is), _count(0), _origin(0) {};
+
+    /// @brief get the next request of the stream
+    virtual bool next(Request *req);
+
+    /// @brief number of requests read so far
+    uint64 count(void) const { return _count; }
+
+    /// @brief origin of the request times (seconds in the trace's timebase)
+    int64  origin(void) const { return _origin; }
+
+    /// @brief save the number of requests read to snapshot @a s
+    virtual void save(Snapshot &s) const;
+
+    /// @brief skip the requests read before the snapshot @a s was taken
+    virtual bool restore(Snapshot &s);
+
+    /// @brief split the decimal timestamp @a str exactly into whole seconds
+    ///        @a sec and nanoseconds @a ns (0 <= @a ns < 1s)
+    /// @retval true if @a str is a valid timestamp, false otherwise
+    static bool parse_timestamp(const char *str, int64 *sec, SimTime *ns);
+
+  protected:
+    istream &_is;                   ///< input stream
+    uint64   _count;                ///< number of requests read
+    int64    _origin;               ///< whole second of the first request
+};
+
+
+//------------------------------------------------------------------------------
+/// @brief request stream held in memory
+///
+/// MemoryWorkload buffers the requests of another workload so that they can
+/// be replayed several times.
+///
+class MemoryWorkload : public Workload {
+  public:
+    /// @brief constructor. Reads all requests of @a source.
+    MemoryWorkload(Workload *source);
+
+    /// @brief get the next request of the stream
+    virtual bool next(Request *req);
+
+    /// @brief restart the stream at the first request
+    void rewind(void) { _pos = 0; }
+
+    /// @brief number of requests
+    size_t size(void) const { return _req.size(); }
+
+    /// @brief save the position in the stream to snapshot @a s
+    virtual void save(Snapshot &s) const;
+
+    /// @brief restore the position in the stream from snapshot @a s
+    virtual bool restore(Snapshot &s);
+
+  protected:
+    vector<Request> _req;           ///< requests
+    size_t _pos;                    ///< index of the next request
+};
+
+
+//------------------------------------------------------------------------------
+/// @brief deterministic pseudo-random number generator (xoshiro256**)
+///
+class Random {
+  public:
+    /// @brief constructor. The state is derived from @a seed by splitmix64.
+    Random(uint64 seed);
+
+    /// @brief next 64-bit random number
+    inline uint64 next(void)
+    {
+      uint64 result = rotl(_s[1] * 5, 7) * 9;
+      uint64 t = _s[1] << 17;
+      _s[2] ^= _s[0];
+      _s[3] ^= _s[1];
+      _s[1] ^= _s[2];
+      _s[0] ^= _s[3];
+      _s[2] ^= t;
+      _s[3] = rotl(_s[3], 45);
+      return result;
+    }
+
+    /// @brief uniformly distributed double in [0, 1)
+    inline double uniform(void)
+    {
+      return (next() >> 11) * (1.0 / 9007199254740992.0);  // 2^-53
+    }
+
+    /// @brief uniformly distributed integer in [0, @a n)
+    inline uint64 below(uint64 n) { return n > 0 ? next() % n : 0; }
+
+    /// @brief exponentially distributed double with mean @a mean
+    double exponential(double mean);
+
+    /// @brief save the generator state to snapshot @a s
+    void   save(Snapshot &s) const;
+
+    /// @brief restore the generator state from snapshot @a s
+    void   restore(Snapshot &s);
+
+  protected:
+    uint64 _s[4];                   ///< generator state
+
+    static inline uint64 rotl(uint64 x, int k)
+    {
+      return (x << k) | (x >> (64 - k));
+    }
+};
+
+
+//------------------------------------------------------------------------------
+/// @brief configuration of a synthetic workload
+///
+/// A configuration is parsed from a comma-separated list of key=value pairs:
+///
+/// - pattern=uniform|sequential|strided|zipf   spatial access pattern
+/// - stride=<bytes>                             distance for strided accesses
+/// - theta=<t>                                  skew of the zipf pattern
+/// - extents=<n>                                number of zipf extents
+/// - read=<fraction>                            fraction of reads (0..1)
+/// - size=<bytes>|uniform:<min>:<max>|exp:<mean>  request size distribution
+/// - arrival=poisson:<iops>|bursty:<iops>:<burst>:<idle>|closed:<iodepth>
+/// - n=<count>                                  number of requests
+/// - seed=<seed>                                random seed
+///
+/// Example: pattern=zipf,theta=0.9,read=0.7,size=uniform:4096:65536,
+///          arrival=poisson:150,n=1000000,seed=42
+///
+typedef enum { PAT_UNIFORM, PAT_SEQUENTIAL, PAT_STRIDED, PAT_ZIPF } Pattern;
+typedef enum { SIZE_FIXED, SIZE_UNIFORM, SIZE_EXP } SizeDist;
+typedef enum { ARR_POISSON, ARR_BURSTY, ARR_CLOSED } Arrival;
+
+typedef struct _workload_config {
+  Pattern  pattern;                 ///< spatial access pattern
+  uint64   stride;                  ///< stride (bytes) of PAT_STRIDED
+  double   theta;                   ///< skew of PAT_ZIPF
+  uint32   extents;                 ///< number of extents of PAT_ZIPF
+  double   read_fraction;           ///< fraction of read requests
+  SizeDist size_dist;               ///< request size distribution
+  uint64   size_min;                ///< (minimal) request size in bytes
+  uint64   size_max;                ///< maximal request size (SIZE_UNIFORM)
+  double   size_mean;               ///< mean request size (SIZE_EXP)
+  Arrival  arrival;                 ///< arrival process
+  double   iops;                    ///< mean arrival rate (ARR_POISSON/BURSTY)
+  uint32   burst;                   ///< requests per burst (ARR_BURSTY)
+  double   idle;                    ///< idle time between bursts (ARR_BURSTY)
+  uint32   iodepth;                 ///< outstanding requests (ARR_CLOSED)
+  uint64   count;                   ///< number of requests
+  uint64   seed;                    ///< random seed
+} WorkloadConfig;
+
+/// @brief initialize @a cfg with default values
+void workload_defaults(WorkloadConfig *cfg);
+
+/// @brief parse @a spec into @a cfg (on top of the values already in @a cfg)
+/// @retval true if @a spec was parsed successfully, false otherwise
+bool workload_parse(const char *spec, WorkloadConfig *cfg);
+
+
+//------------------------------------------------------------------------------
+/// @brief synthetic request stream
+///
+/// SyntheticWorkload generates requests in memory according to a
+/// WorkloadConfig. Addresses and sizes are multiples of the sector size and
+/// all requests lie within the capacity of the device. For a given seed the
+/// generated stream is always the same. Requests of closed-loop workloads
+/// have no meaningful timestamp; they are issued by the replay engine.
+///
+class SyntheticWorkload : public Workload {
+  public:
+    /// @name constructor/destructor
+    /// @{
+
+    /// @brief constructor
+    /// @param cfg workload configuration
+    /// @param capacity capacity of the device in bytes
+    /// @param sector_size sector size of the device in bytes
+    SyntheticWorkload(const WorkloadConfig &cfg, uint64 capacity,
+                      uint32 sector_size);
+
+    /// @brief destructor
+    virtual ~SyntheticWorkload(void);
+
+    /// @}
+
+
+    /// @name access methods
+    /// @{
+
+    /// @brief get the next request of the stream
+    virtual bool next(Request *req);
+
+    /// @}
+
+
+    /// @name snapshots
+    /// @{
+
+    /// @brief save the state of the generator to snapshot @a s
+    virtual void save(Snapshot &s) const;
+
+    /// @brief restore the state of the generator from snapshot @a s
+    virtual bool restore(Snapshot &s);
+
+    /// @}
+
+
+  protected:
+    WorkloadConfig _cfg;            ///< configuration
+    Random _rng;                    ///< random number generator
+    uint64 _sectors;                ///< capacity of the device in sectors
+    uint32 _sector_size;            ///< number of bytes per sector
+    uint64 _generated;              ///< number of requests generated so far
+    uint64 _next_sector;            ///< next sector (sequential/strided)
+    SimTime _ts;                    ///< timestamp of the last request
+    vector<double> _zipf_cdf;       ///< cumulative zipf distribution of extents
+
+    /// @brief size (in sectors) of the next request
+    uint64 next_size(void);
+
+    /// @brief starting sector of the next request of @a sectors sectors
+    uint64 next_sector(uint64 sectors);
+
+    /// @brief arrival time of the next request
+    SimTime next_arrival(void);
+};
+
+#endif // __CA_WORKLOAD_H__